@@ -29,19 +29,18 @@
 #include "IfxScuWdt.h"
 #include "LCD.h"
 #include "LCD_PINSET.h"
+#include "LCD_Server.h"
 
 IfxCpu_syncEvent g_cpuSyncEvent = 0;
 
-LCD_PIN E = {.port = &MODULE_P15, .pinIndex = 3};
-LCD_PIN RS = {.port = &MODULE_P15, .pinIndex = 2};
-LCD_PIN RW = {.port = &MODULE_P02, .pinIndex = 0};
-LCD_PIN DB4 = {.port = &MODULE_P02, .pinIndex = 1};
-LCD_PIN DB5 = {.port = &MODULE_P10, .pinIndex = 4};
-LCD_PIN DB6 = {.port = &MODULE_P02, .pinIndex = 3};
-LCD_PIN DB7 = {.port = &MODULE_P02, .pinIndex = 5};
+LCD_DEFINE(Lcd, 0, PIN_E, PIN_RS, PIN_RW, PIN_DB4, PIN_DB5, PIN_DB6, PIN_DB7);
 
 uint8 string[] = "HELLO WORLD";
 
+/*Core 0 owns the LCD, the other cores post their text through these queues*/
+LCD_SERVER_QUEUE g_lcdQueues[LCD_SERVER_CORES] LCD_LMU_SECTION;
+LCD_SERVER LcdServer;
+
 
 int core0_main(void)
 {
@@ -53,30 +52,34 @@ int core0_main(void)
     IfxScuWdt_disableCpuWatchdog(IfxScuWdt_getCpuWatchdogPassword());
     IfxScuWdt_disableSafetyWatchdog(IfxScuWdt_getSafetyWatchdogPassword());
     
-    /* Wait for CPU sync event */
-    IfxCpu_emitEvent(&g_cpuSyncEvent);
-    IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
-    
     Pin_LCD_init();
 
     //LCD Init
-    LCD *Lcd = LCD_Init(&E, &RS, &RW, &DB4, &DB5, &DB6, &DB7);
+    LCD_InitStatic(&Lcd, &Lcd_config);
 
     //LCD Begin
-    LCD_Begin(Lcd);
+    LCD_Begin(&Lcd);
 
     //LCD Clear Screen
-    LCD_ClearScreen(Lcd);
+    LCD_ClearScreen(&Lcd);
 
     //LCD Set Cursor
-    LCD_SetCursor(Lcd, 0, 0);
+    LCD_SetCursor(&Lcd, 0, 0);
 
     //LCD Put String
-    LCD_PutStr(Lcd, string);
+    LCD_PutStr(&Lcd, string);
+
+    //LCD Server, ready before the other cores post
+    LCD_ServerInit(&LcdServer, &Lcd, g_lcdQueues, 100000);
+
+    /* Wait for CPU sync event */
+    IfxCpu_emitEvent(&g_cpuSyncEvent);
+    IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
 
     while(1)
     {
-
+        //Show what the other cores posted
+        LCD_ServerPoll(&LcdServer);
     }
     return (1);
 }
@@ -27,8 +27,12 @@
 #include "Ifx_Types.h"
 #include "IfxCpu.h"
 #include "IfxScuWdt.h"
+#include "LCD_Server.h"
 
 extern IfxCpu_syncEvent g_cpuSyncEvent;
+extern LCD_SERVER_QUEUE g_lcdQueues[LCD_SERVER_CORES];
+
+uint8 string2[] = "CPU2";
 
 int core2_main(void)
 {
@@ -43,6 +47,9 @@ int core2_main(void)
     IfxCpu_emitEvent(&g_cpuSyncEvent);
     IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
     
+    //LCD Post String, core 0 shows it
+    LCD_ServerPost(g_lcdQueues, 1, 8, string2);
+
     while(1)
     {
     }
@@ -12,78 +12,1068 @@
 /*********************************************************************************************************************/
 #include "LCD.h"
 #include <Stm/Std/IfxStm.h>
+#include <Gtm/Std/IfxGtm.h>
+#include <Gtm/Std/IfxGtm_Cmu.h>
+#include <Gtm/Std/IfxGtm_Tom.h>
+#if LCD_USE_HEAP
 #include <stdlib.h>
+#endif
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------------Macros------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*STM Module uses to generate a delay function*/
+#define STM             &MODULE_STM0
+
+/*This macro set the state of a pin
+ * if arg > 0, the pin will be high
+ * if arg = 0, the pin will be low
+ */
+#define STATE(arg)  ((arg) ? IfxPort_State_high : IfxPort_State_low)
+/*Longest text of LCD_PrintField: the 10 digits of a uint32 and the point, the sign is written apart*/
+#define LCD_FIELD_TEXT  11
+
+#if LCD_USE_STATS
+#define LCD_COUNT(lcd, field, n)    ((lcd)->stats.field += (n))
+#else
+#define LCD_COUNT(lcd, field, n)    ((void)0)
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Global Variables-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+const LCD_GEOMETRY LCD_Geometry_16x1 = {.cols = 16, .rows = 1, .rowOffset = {0X00}};
+const LCD_GEOMETRY LCD_Geometry_16x2 = {.cols = 16, .rows = 2, .rowOffset = {0X00, 0X40}};
+const LCD_GEOMETRY LCD_Geometry_20x2 = {.cols = 20, .rows = 2, .rowOffset = {0X00, 0X40}};
+const LCD_GEOMETRY LCD_Geometry_20x4 = {.cols = 20, .rows = 4, .rowOffset = {0X00, 0X40, 0X14, 0X54}};
+const LCD_GEOMETRY LCD_Geometry_40x2 = {.cols = 40, .rows = 2, .rowOffset = {0X00, 0X40}};
+
+//Bars of 1 to 5 pixel columns, the top and bottom rows are left blank so stacked bars do not touch.
+static const uint8 LCD_BarGlyphs[5][LCD_GLYPH_ROWS] = {
+        {0X00, 0X10, 0X10, 0X10, 0X10, 0X10, 0X10, 0X00},
+        {0X00, 0X18, 0X18, 0X18, 0X18, 0X18, 0X18, 0X00},
+        {0X00, 0X1C, 0X1C, 0X1C, 0X1C, 0X1C, 0X1C, 0X00},
+        {0X00, 0X1E, 0X1E, 0X1E, 0X1E, 0X1E, 0X1E, 0X00},
+        {0X00, 0X1F, 0X1F, 0X1F, 0X1F, 0X1F, 0X1F, 0X00}
+};
+
+//Strokes of the big digits: upper, lower and both. The full block is the 0XFF char of the ROM.
+static const uint8 LCD_BigGlyphs[3][LCD_GLYPH_ROWS] = {
+        {0X1F, 0X1F, 0X1F, 0X00, 0X00, 0X00, 0X00, 0X00},
+        {0X00, 0X00, 0X00, 0X00, 0X00, 0X1F, 0X1F, 0X1F},
+        {0X1F, 0X1F, 0X00, 0X00, 0X00, 0X00, 0X1F, 0X1F}
+};
+
+//Big digits, upper row then lower row: ' ' blank, 'F' full block, 'U' upper, 'L' lower, 'B' both strokes.
+static const char LCD_BigDigits[10][2][4] = {
+        {"FUF", "FLF"}, {"UF ", "LFL"}, {"BBF", "FLL"}, {"BBF", "LLF"}, {"FLF", "  F"},
+        {"FBB", "LLF"}, {"FBB", "FLF"}, {"UUF", "  F"}, {"FBF", "FLF"}, {"FBF", "LLF"}
+};
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Private Functions-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_TicksFromNs.
+ * @brief: Convert a time in ns to STM ticks, rounded up so a minimum time is never violated.
+ */
+static uint32 LCD_TicksFromNs(uint32 time_ns)
+{
+    float32 ticks = IfxStm_getFrequency(STM) * (float32)time_ns / 1000000000.0f;
+    return (uint32)ticks + 1;
+}
+
+/*
+ * @LCD_StrobeStart
+ * @brief: Start the one-shot pulse of the TOM channel, E goes high for CM1 ticks.
+ */
+static void LCD_StrobeStart(LCD_STROBE *strobe)
+{
+    IfxGtm_Tom_Ch_clearZeroNotification(strobe->tom.tom, strobe->tom.tomChannel);
+    IfxGtm_Tom_Ch_setCounterValue(strobe->tom.tom, strobe->tom.tomChannel, 0);
+}
+
+/*
+ * @LCD_StrobeWait
+ * @brief: Wait for the end of the enable cycle, the counter reaches CM0 and stops in one-shot mode.
+ */
+static void LCD_StrobeWait(LCD_STROBE *strobe)
+{
+    while(!IfxGtm_Tom_Ch_isZeroNotification(strobe->tom.tom, strobe->tom.tomChannel))
+    {}
+}
+
+/*
+ * @LCD_StrobeTiming
+ * @brief: Convert the enable times to GTM ticks and load them in the TOM channel.
+ */
+static void LCD_StrobeTiming(LCD *LCD_Struct)
+{
+    LCD_STROBE *strobe = LCD_Struct->strobe;
+    float32 ticksPerNs = IfxGtm_Tom_Ch_getClockFrequency(strobe->tom.gtm, strobe->tom.tom, strobe->tom.tomChannel) / 1000000000.0f;
+    uint32 cycle_ns = LCD_Struct->timing.enableCycle_ns;
+
+    //E must also stay low for at least the pulse width.
+    if(cycle_ns < 2 * LCD_Struct->timing.enablePulse_ns)
+        cycle_ns = 2 * LCD_Struct->timing.enablePulse_ns;
+
+    strobe->pulseTicks = (uint32)(ticksPerNs * LCD_Struct->timing.enablePulse_ns) + 1;
+    strobe->cycleTicks = (uint32)(ticksPerNs * cycle_ns) + 1;
+    strobe->dataDelayTicks = (uint32)(ticksPerNs * LCD_TIMING_DATA_DELAY_NS) + 1;
+    IfxGtm_Tom_Ch_setCompare(strobe->tom.tom, strobe->tom.tomChannel, strobe->cycleTicks, strobe->pulseTicks);
+}
+
+/*
+ * @LCD_DmaTiming
+ * @brief: Set the period of the TOM channel pacing the DMA and the number of periods of the execution times.
+ *         A period is the data setup, the E pulse and half of the enable cycle, whichever is the longest.
+ */
+static void LCD_DmaTiming(LCD *LCD_Struct)
+{
+    LCD_DMA *dma = LCD_Struct->dma;
+    float32 ticksPerNs = IfxGtm_Tom_Ch_getClockFrequency(dma->tick.gtm, dma->tick.tom, dma->tick.tomChannel) / 1000000000.0f;
+    uint32 period_ns = LCD_Struct->timing.addressSetup_ns;
+    uint32 periodTicks;
+
+    if(period_ns < LCD_Struct->timing.enablePulse_ns)
+        period_ns = LCD_Struct->timing.enablePulse_ns;
+    if(period_ns < (LCD_Struct->timing.enableCycle_ns + 1) / 2)
+        period_ns = (LCD_Struct->timing.enableCycle_ns + 1) / 2;
+
+    periodTicks = (uint32)(ticksPerNs * period_ns) + 1;
+    //Back to ns of whole ticks, so the execution times are never shortened.
+    period_ns = (uint32)(periodTicks / ticksPerNs);
+    if(period_ns == 0)
+        period_ns = 1;
+
+    //The transfer count of a transaction set is 14 bits.
+    dma->execTransfers = (uint16)__min((LCD_Struct->timing.exec_us * 1000 + period_ns - 1) / period_ns + 1, 0X3FFF);
+    dma->clearHomeTransfers = (uint16)__min((LCD_Struct->timing.clearHome_us * 1000 + period_ns - 1) / period_ns + 1, 0X3FFF);
+    IfxGtm_Tom_Ch_setCompare(dma->tick.tom, dma->tick.tomChannel, periodTicks, periodTicks / 2);
+}
+
+/*
+ * @LCD_Enable
+ * @brief: Function to strobe the enable pin, data is latched on the falling edge.
+ */
+static void LCD_Enable(LCD *LCD_Struct)
+{
+    if(LCD_Struct->strobe != NULL){
+        //The pulse width is exact, waiting the end of the cycle also keeps the data hold time.
+        LCD_StrobeStart(LCD_Struct->strobe);
+        LCD_StrobeWait(LCD_Struct->strobe);
+        return;
+    }
+
+    IfxPort_setPinHigh(LCD_Struct->E->port,LCD_Struct->E->pinIndex);
+    IfxStm_waitTicks(STM, LCD_Struct->enableHighTicks);
+    IfxPort_setPinLow(LCD_Struct->E->port,LCD_Struct->E->pinIndex);
+    IfxStm_waitTicks(STM, LCD_Struct->enableLowTicks);
+}
+
+/*
+ * @LCD_DataPins.
+ * @brief: Fill pins with DB0-DB7 by bit number and return the first bit in use, 0 in 8 bits mode, 4 in 4 bits mode.
+ */
+static uint8 LCD_DataPins(const LCD *LCD_Struct, const LCD_PIN *pins[8])
+{
+    pins[0] = LCD_Struct->DB0;
+    pins[1] = LCD_Struct->DB1;
+    pins[2] = LCD_Struct->DB2;
+    pins[3] = LCD_Struct->DB3;
+    pins[4] = LCD_Struct->DB4;
+    pins[5] = LCD_Struct->DB5;
+    pins[6] = LCD_Struct->DB6;
+    pins[7] = LCD_Struct->DB7;
+
+    return LCD_Struct->mode8Bits ? 0 : 4;
+}
+
+/*
+ * @LCD_Write_bus.
+ * @brief: Function to write the data bus and strobe it, one OMR write per port of the data bus.
+ *         In 4 bits mode only the upper nibble of value is written.
+ */
+static void LCD_Write_bus(LCD *LCD_Struct, uint8 value)
+{
+    for(uint8 g = 0; g < LCD_Struct->busGroups; ++g){
+        uint32 omr = LCD_Struct->bus[g].omrHigh[value >> 4];
+
+        if(LCD_Struct->mode8Bits)
+            omr |= LCD_Struct->bus[g].omrLow[value & 0X0F];
+        LCD_Struct->bus[g].port->OMR.U = omr;
+    }
+    LCD_Enable(LCD_Struct);
+}
+
+/*
+ * @LCD_InitBus.
+ * @brief: Group the data bus pins by port and compute the OMR word of each nibble value.
+ *         The set bits are in the lower half of OMR, the clear bits in the upper half.
+ */
+static void LCD_InitBus(LCD *LCD_Struct)
+{
+    const LCD_PIN *pins[8];
+    uint8 first;
+
+    //Unknown level, the first transfer writes it.
+    LCD_Struct->rsState = 0XFF;
+    if(LCD_Struct->transport != NULL)
+        return;
+
+    LCD_Struct->mode8Bits = (LCD_Struct->DB0 != NULL) && (LCD_Struct->DB0->port != NULL);
+    first = LCD_DataPins(LCD_Struct, pins);
+
+    LCD_Struct->busGroups = 0;
+    for(uint8 bit = first; bit < 8; ++bit){
+        LCD_BUS_GROUP *group = NULL;
+        uint32 pinMask = 1U << pins[bit]->pinIndex;
+        uint32 *omr;
+
+        for(uint8 g = 0; g < LCD_Struct->busGroups; ++g){
+            if(LCD_Struct->bus[g].port == pins[bit]->port)
+                group = &LCD_Struct->bus[g];
+        }
+        if(group == NULL){
+            group = &LCD_Struct->bus[LCD_Struct->busGroups++];
+            group->port = pins[bit]->port;
+            memset(group->omrHigh, 0, sizeof(group->omrHigh));
+            memset(group->omrLow, 0, sizeof(group->omrLow));
+        }
+
+        omr = (bit >= 4) ? group->omrHigh : group->omrLow;
+        for(uint8 value = 0; value < 16; ++value){
+            omr[value] |= (value & (1U << (bit & 0X03))) ? pinMask : (pinMask << 16);
+        }
+    }
+
+}
+
+/*
+ * @LCD_SetDataBusInput.
+ * @brief: Function to switch the data bus between input, to read the LCD, and output.
+ */
+static void LCD_SetDataBusInput(LCD *LCD_Struct, boolean input)
+{
+    const LCD_PIN *pins[8];
+
+    for(uint8 bit = LCD_DataPins(LCD_Struct, pins); bit < 8; ++bit){
+        if(input)
+            IfxPort_setPinModeInput(pins[bit]->port, pins[bit]->pinIndex, IfxPort_InputMode_pullUp);
+        else
+            IfxPort_setPinModeOutput(pins[bit]->port, pins[bit]->pinIndex, IfxPort_OutputMode_pushPull, IfxPort_OutputIdx_general);
+    }
+}
+
+/*
+ * @LCD_Read_bus.
+ * @brief: Function to read the data bus, it must be input and RW high. In 4 bits mode the nibble is in the upper half.
+ */
+static uint8 LCD_Read_bus(LCD *LCD_Struct)
+{
+    const LCD_PIN *pins[8];
+    uint8 first = LCD_DataPins(LCD_Struct, pins);
+    uint8 data = 0;
+
+    if(LCD_Struct->strobe != NULL){
+        LCD_STROBE *strobe = LCD_Struct->strobe;
+        volatile uint32 *counter = IfxGtm_Tom_Ch_getTimerPointer(strobe->tom.tom, strobe->tom.tomChannel);
+        boolean interruptState = IfxCpu_disableInterrupts();
+
+        //The bus is sampled between tDDR and the falling edge, no interrupt may land in between.
+        LCD_StrobeStart(strobe);
+        while(*counter < strobe->dataDelayTicks)
+        {}
+        for(uint8 bit = first; bit < 8; ++bit){
+            data |= IfxPort_getPinState(pins[bit]->port, pins[bit]->pinIndex) << bit;
+        }
+        IfxCpu_restoreInterrupts(interruptState);
+        LCD_StrobeWait(strobe);
+        return data;
+    }
+
+    IfxPort_setPinHigh(LCD_Struct->E->port,LCD_Struct->E->pinIndex);
+    //The enable pulse is longer than the data delay time (tDDR).
+    IfxStm_waitTicks(STM, LCD_Struct->enableHighTicks);
+    for(uint8 bit = first; bit < 8; ++bit){
+        data |= IfxPort_getPinState(pins[bit]->port, pins[bit]->pinIndex) << bit;
+    }
+    IfxPort_setPinLow(LCD_Struct->E->port,LCD_Struct->E->pinIndex);
+    IfxStm_waitTicks(STM, LCD_Struct->enableLowTicks);
+
+    return data;
+}
+
+/*
+ * @LCD_Read_byte.
+ * @brief: Function to read a byte from the LCD, busy flag and address with RS = 0, data with RS = 1.
+ */
+static uint8 LCD_Read_byte(LCD *LCD_Struct, IfxPort_State rs)
+{
+    uint8 data;
+
+    //The transports only write.
+    if(LCD_Struct->transport != NULL)
+        return 0;
+
+    LCD_SetDataBusInput(LCD_Struct, TRUE);
+    IfxPort_setPinState(LCD_Struct->RS->port, LCD_Struct->RS->pinIndex, rs);
+    LCD_Struct->rsState = (rs == IfxPort_State_high) ? LCD_SEND_DATA : 0;
+    IfxPort_setPinState(LCD_Struct->RW->port, LCD_Struct->RW->pinIndex, IfxPort_State_high);
+    IfxStm_waitTicks(STM, LCD_Struct->addressSetupTicks);
+
+    data = LCD_Read_bus(LCD_Struct);
+    if(!LCD_Struct->mode8Bits)
+        data |= LCD_Read_bus(LCD_Struct) >> 4;
+
+    IfxPort_setPinState(LCD_Struct->RW->port, LCD_Struct->RW->pinIndex, IfxPort_State_low);
+    LCD_SetDataBusInput(LCD_Struct, FALSE);
+
+    return data;
+}
+
+/*
+ * @LCD_WaitReady.
+ * @brief: In busy flag mode, poll the busy flag until the controller accepts the next instruction.
+ *         On timeout the LCD is not answering, so busy flag mode is left and the fixed delays are used.
+ */
+static void LCD_WaitReady(LCD *LCD_Struct)
+{
+    uint32 beginTime;
+
+    if(!LCD_Struct->useBusyFlag || (LCD_Struct->transport != NULL))
+        return;
+
+    beginTime = IfxStm_getLower(STM);
+    while(LCD_Read_byte(LCD_Struct, IfxPort_State_low) & LCD_BUSYFLAG){
+        if((IfxStm_getLower(STM) - beginTime) >= LCD_Struct->busyTimeoutTicks){
+            LCD_Struct->useBusyFlag = FALSE;
+            ++LCD_Struct->busyTimeouts;
+            return;
+        }
+    }
+}
+
+/*
+ * @LCD_TransportSync.
+ * @brief: Send the bytes queued in the transport and return once they are written, so a wait can start.
+ */
+static void LCD_TransportSync(LCD *LCD_Struct)
+{
+    LCD_Struct->transport->flush(LCD_Struct);
+    if(LCD_Struct->transport->isBusy != NULL){
+        while(LCD_Struct->transport->isBusy(LCD_Struct))
+        {}
+    }
+}
+
+/*
+ * @LCD_Write_byte.
+ * @brief: Function to write a command or data byte on the LCD, without waiting its execution.
+ */
+static void LCD_Write_byte(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    uint8 rs = flags & LCD_SEND_DATA;
+
+    if(rs)
+        LCD_COUNT(LCD_Struct, dataBytes, 1);
+    else
+        LCD_COUNT(LCD_Struct, commands, 1);
+    LCD_COUNT(LCD_Struct, strobes, LCD_Struct->mode8Bits ? 1 : 2);
+
+    if(LCD_Struct->transport != NULL){
+        LCD_Struct->transport->write(LCD_Struct, flags, value);
+        return;
+    }
+
+    //RW is only high while reading, so only RS may need to change.
+    if(rs != LCD_Struct->rsState){
+        IfxPort_setPinState(LCD_Struct->RS->port, LCD_Struct->RS->pinIndex, STATE(rs));
+        LCD_Struct->rsState = rs;
+        IfxStm_waitTicks(STM, LCD_Struct->addressSetupTicks);
+    }
+
+    LCD_Write_bus(LCD_Struct, value);
+    if(!LCD_Struct->mode8Bits)
+        LCD_Write_bus(LCD_Struct, (uint8)(value << 4));
+}
+
+/*
+ * @LCD_AsyncHandshake.
+ * @brief: Take the lock that orders the kick of LCD_AsyncPush and the empty check of LCD_AsyncIsr, which may run on
+ *         another CPU. The interrupts are disabled first, so an ISR on this CPU cannot spin on it.
+ */
+static boolean LCD_AsyncHandshake(LCD_ASYNC *async)
+{
+    boolean interruptState = IfxCpu_disableInterrupts();
+
+    while(!IfxCpu_setSpinLock(&async->lock, 0XFFFFFFFF))
+    {}
+    return interruptState;
+}
+
+/*
+ * @LCD_AsyncPush.
+ * @brief: Queue a transfer and start the interrupt if it is idle. The public call has reserved the room with
+ *         @ref LCD_Reserve, so the queue is never full here.
+ */
+static void LCD_AsyncPush(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    LCD_ASYNC *async = LCD_Struct->async;
+    uint8 transfer[2] = {flags, value};
+    uint32 depth;
+    boolean interruptState;
+
+    Ifx_Fifo_write(async->fifo, transfer, sizeof(transfer), TIME_NULL);
+
+    depth = Ifx_Fifo_readCount(async->fifo) / sizeof(transfer);
+    if(depth > async->maxDepth)
+        async->maxDepth = depth;
+
+    //The interrupt clears busy when it finds the queue empty, it cannot run in between.
+    interruptState = LCD_AsyncHandshake(async);
+    if(!async->busy){
+        async->busy = TRUE;
+        async->drainStart = IfxStm_getLower(async->stm);
+        IfxSrc_setRequest(IfxStm_getSrcPointer(async->stm, async->comparator));
+    }
+    IfxCpu_resetSpinLock(&async->lock);
+    IfxCpu_restoreInterrupts(interruptState);
+}
+
+/*
+ * @LCD_Reserve.
+ * @brief: Check that the transmit queue has room for every transfer of a public call, before the call changes the
+ *         shadow or the address counter. The lock must be taken: only its owner pushes and the interrupt only makes
+ *         room, so the room stays until the call ends.
+ * @return: FALSE if the call must be dropped, it is counted in the overruns.
+ */
+static boolean LCD_Reserve(LCD *LCD_Struct, uint32 transfers)
+{
+    LCD_ASYNC *async = LCD_Struct->async;
+
+    if((async == NULL) || ((uint32)Ifx_Fifo_writeCount(async->fifo) >= transfers * 2))
+        return TRUE;
+    ++async->overruns;
+    return FALSE;
+}
+
+/*
+ * @LCD_Write_nibble.
+ * @brief: Write the upper nibble of a command, as the LCD expects it during the initialization by instruction.
+ */
+static void LCD_Write_nibble(LCD *LCD_Struct, uint8 value)
+{
+    LCD_COUNT(LCD_Struct, commands, 1);
+    LCD_COUNT(LCD_Struct, strobes, 1);
+    if(LCD_Struct->transport != NULL)
+        LCD_Struct->transport->write(LCD_Struct, LCD_SEND_NIBBLE, value);
+    else
+        LCD_Write_bus(LCD_Struct, value);
+}
+
+/*
+ * @LCD_DmaAddress.
+ * @brief: Address of a variable as seen by the DMA, local DSPR addresses are those of the calling CPU.
+ */
+static uint32 LCD_DmaAddress(const volatile void *address)
+{
+    return IFXCPU_GLB_ADDR_DSPR(IfxCpu_getCoreId(), address);
+}
+
+/*
+ * @LCD_DmaEntry.
+ * @brief: Append a transaction set writing count words to the OMR of a port, one word per period.
+ *         With repeat the same word is written count times.
+ */
+static void LCD_DmaEntry(LCD_DMA *dma, volatile void *destination, const uint32 *source, uint16 count, boolean repeat)
+{
+    IfxDma_Dma_ChannelConfig *config = &dma->config;
+
+    config->sourceAddress = LCD_DmaAddress(source);
+    config->destinationAddress = (uint32)destination;
+    config->transferCount = count;
+    config->sourceCircularBufferEnabled = repeat;
+    config->shadowAddress = LCD_DmaAddress(&dma->list[dma->entries + 1]);
+    IfxDma_Dma_initLinkedListEntry((void *)&dma->list[dma->entries++], config);
+}
+
+/*
+ * @LCD_DmaIdle.
+ * @brief: Wait for the list being played, then empty it.
+ */
+static void LCD_DmaIdle(LCD *LCD_Struct)
+{
+    LCD_DmaWait(LCD_Struct);
+    LCD_Struct->dma->entries = 0;
+    LCD_Struct->dma->wordCount = 0;
+}
+
+/*
+ * @LCD_DmaStart.
+ * @brief: Terminate the list and start it, the lock must be taken.
+ */
+static void LCD_DmaStart(LCD *LCD_Struct)
+{
+    LCD_DMA *dma = LCD_Struct->dma;
+    IfxDma_Dma_ChannelConfig config = dma->config;
+
+    //The last transaction set disables the TOM channel, so no request is left for the idle DMA channel.
+    dma->config.shadowControl = IfxDma_ChannelShadow_none;
+    LCD_DmaEntry(dma, &dma->tick.tgc[0]->ENDIS_STAT.U, &dma->stopWord, 1, FALSE);
+    dma->config.shadowControl = IfxDma_ChannelShadow_linkedList;
+
+    if(dma->entries > dma->maxEntries)
+        dma->maxEntries = dma->entries;
+    ++dma->runs;
+    dma->running = TRUE;
+
+    //The channel starts with one write of E low, then loads the first transaction set of the list.
+    config.sourceAddress = LCD_DmaAddress(&dma->eWords[1]);
+    config.destinationAddress = (uint32)&LCD_Struct->E->port->OMR.U;
+    config.transferCount = 1;
+    config.shadowAddress = LCD_DmaAddress(&dma->list[0]);
+    IfxDma_Dma_initChannel(&dma->channel, &config);
+    IfxDma_Dma_startChannelTransaction(&dma->channel);
+    IfxGtm_Tom_Tgc_enableChannel(dma->tick.tgc[0], dma->tick.tomChannel, TRUE, TRUE);
+}
+
+/*
+ * @LCD_DmaCompile.
+ * @brief: Append the transaction sets of a command or data byte, starting the list first if it is full.
+ */
+static void LCD_DmaCompile(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    LCD_DMA *dma = LCD_Struct->dma;
+    uint8 rs = flags & LCD_SEND_DATA;
+    uint8 nibbles = LCD_Struct->mode8Bits ? 1 : 2;
+
+    if(rs)
+        LCD_COUNT(LCD_Struct, dataBytes, 1);
+    else
+        LCD_COUNT(LCD_Struct, commands, 1);
+    LCD_COUNT(LCD_Struct, strobes, nibbles);
+
+    if(dma->running)
+        LCD_DmaIdle(LCD_Struct);
+    //RS, data and E of each nibble, the execution time and the final transaction set.
+    if(dma->entries + 3 + nibbles * (LCD_Struct->busGroups + 1) > LCD_DMA_LIST_LENGTH){
+        LCD_DmaStart(LCD_Struct);
+        LCD_DmaIdle(LCD_Struct);
+    }
+
+    if(rs != LCD_Struct->rsState){
+        LCD_DmaEntry(dma, &LCD_Struct->RS->port->OMR.U, &dma->rsWords[rs], 1, FALSE);
+        LCD_Struct->rsState = rs;
+    }
+
+    for(uint8 n = 0; n < nibbles; ++n){
+        uint8 bus = (n == 0) ? value : (uint8)(value << 4);
+
+        for(uint8 g = 0; g < LCD_Struct->busGroups; ++g){
+            uint32 *word = &dma->words[dma->wordCount++];
+
+            *word = LCD_Struct->bus[g].omrHigh[bus >> 4];
+            if(LCD_Struct->mode8Bits)
+                *word |= LCD_Struct->bus[g].omrLow[bus & 0X0F];
+            LCD_DmaEntry(dma, &LCD_Struct->bus[g].port->OMR.U, word, 1, FALSE);
+        }
+        LCD_DmaEntry(dma, &LCD_Struct->E->port->OMR.U, dma->eWords, 2, FALSE);
+    }
+
+    LCD_DmaEntry(dma, &LCD_Struct->E->port->OMR.U, &dma->eWords[1],
+            (flags & LCD_SEND_LONG) ? dma->clearHomeTransfers : dma->execTransfers, TRUE);
+}
+
+/*
+ * @LCD_Send.
+ * @brief: Function to send a command or data byte, waiting until the LCD has executed it.
+ *         In asynchronous mode the byte is queued instead.
+ */
+static void LCD_Send(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    if(LCD_Struct->async != NULL){
+        LCD_AsyncPush(LCD_Struct, flags, value);
+        return;
+    }
+    if(LCD_Struct->dma != NULL){
+        LCD_DmaCompile(LCD_Struct, flags, value);
+        return;
+    }
+    //The serial bus is slower than the execution time, only clear and home need to be waited.
+    if(LCD_Struct->transport != NULL){
+        LCD_Write_byte(LCD_Struct, flags, value);
+        if(flags & LCD_SEND_LONG){
+            LCD_TransportSync(LCD_Struct);
+            IfxStm_waitTicks(STM, LCD_Struct->clearHomeTicks);
+        }
+        return;
+    }
+
+    LCD_WaitReady(LCD_Struct);
+    LCD_Write_byte(LCD_Struct, flags, value);
+    if(!LCD_Struct->useBusyFlag)
+        IfxStm_waitTicks(STM, (flags & LCD_SEND_LONG) ? LCD_Struct->clearHomeTicks : LCD_Struct->execTicks);
+}
+
+/*
+ * @LCD_Lock.
+ * @brief: Take the LCD for the whole public function, so transfers of another CPU are not interleaved.
+ *         Also used by the transport backends, see LCD.h.
+ */
+void LCD_Lock(LCD *LCD_Struct, LCD_Call call)
+{
+#if LCD_USE_STATS
+    uint32 start = IfxCpu_getClockCounter();
+#endif
+
+    while(!IfxCpu_setSpinLock(&LCD_Struct->lock, 0XFFFFFFFF))
+    {}
+#if LCD_USE_STATS
+    LCD_Struct->stats.start = start;
+    LCD_Struct->stats.call = call;
+#else
+    (void)call;
+#endif
+}
+
+#if LCD_USE_STATS
+/*
+ * @LCD_StatsRecord.
+ * @brief: Account the cycles of the call that ends, the lock is still taken.
+ */
+static void LCD_StatsRecord(LCD *LCD_Struct)
+{
+    LCD_STATS *stats = &LCD_Struct->stats;
+    uint32 cycles = (IfxCpu_getClockCounter() - stats->start) & 0X7FFFFFFF;    //The clock counter has 31 bits.
+    uint32 scaled = cycles >> 9;
+    uint8 bin = 0;
+
+    while((scaled != 0) && (bin < LCD_STATS_BINS - 1)){
+        scaled >>= 1;
+        ++bin;
+    }
+    stats->cycles += cycles;
+    ++stats->calls[stats->call];
+    ++stats->histogram[stats->call][bin];
+    if(cycles > stats->worstCycles){
+        stats->worstCycles = cycles;
+        stats->worstCall = stats->call;
+    }
+}
+#endif
+
+/*
+ * @LCD_Unlock.
+ * @brief: Release the LCD taken by @ref LCD_Lock.
+ */
+void LCD_Unlock(LCD *LCD_Struct)
+{
+    //The transfers compiled by the public function are played as one DMA list.
+    if((LCD_Struct->dma != NULL) && !LCD_Struct->dma->running && (LCD_Struct->dma->entries > 0))
+        LCD_DmaStart(LCD_Struct);
+    //In asynchronous mode only the interrupt writes to the transport.
+    if((LCD_Struct->transport != NULL) && (LCD_Struct->async == NULL))
+        LCD_Struct->transport->flush(LCD_Struct);
+#if LCD_USE_STATS
+    LCD_StatsRecord(LCD_Struct);
+#endif
+    IfxCpu_resetSpinLock(&LCD_Struct->lock);
+}
+
+/*
+ * @LCD_Clear.
+ * @brief: Clear display and both frames, the lock must be taken.
+ */
+static void LCD_Clear(LCD *LCD_Struct)
+{
+    LCD_Send(LCD_Struct, LCD_SEND_LONG, LCD_CLEARDISPLAY);
+    LCD_Struct->col = 0;
+    LCD_Struct->row = 0;
+    LCD_Struct->address = 0;
+    //Clear and home also undo the display shift.
+    LCD_Struct->marquee = NULL;
+
+    memset(LCD_Struct->frame, ' ', sizeof(LCD_Struct->frame));
+    memset(LCD_Struct->shadow, ' ', sizeof(LCD_Struct->shadow));
+}
+
+/*
+ * @LCD_ReturnHome.
+ * @brief: Return home, the lock must be taken.
+ */
+static void LCD_ReturnHome(LCD *LCD_Struct)
+{
+    LCD_Send(LCD_Struct, LCD_SEND_LONG, LCD_RETURNHOME);
+    LCD_Struct->col = 0;
+    LCD_Struct->row = 0;
+    LCD_Struct->address = 0;
+    LCD_Struct->marquee = NULL;
+}
+
+/*
+ * @LCD_NextAddress.
+ * @brief: Address counter after a write or read, the entry mode increases it.
+ *         In 2-line mode it jumps from the end of the 1st line (0x27) to the 2nd line (0x40) and back to 0x00.
+ */
+static uint8 LCD_NextAddress(const LCD *LCD_Struct, uint8 address)
+{
+    if(address == LCD_ADDRESS_UNKNOWN)
+        return LCD_ADDRESS_UNKNOWN;
+
+    if(LCD_Struct->geometry->rows == 1)
+        return (address >= 0X4F) ? 0X00 : address + 1;
+
+    if(address == 0X27)
+        return 0X40;
+    return (address >= 0X67) ? 0X00 : address + 1;
+}
+
+/*
+ * @LCD_Locate.
+ * @brief: Move the cursor to a position, the address is only sent if the address counter is not there yet.
+ *         The lock must be taken, row and column must be inside the panel.
+ */
+static void LCD_Locate(LCD *LCD_Struct, uint8 row, uint8 col)
+{
+    uint8 address = LCD_Struct->geometry->rowOffset[row] + col;
+
+    if(address != LCD_Struct->address){
+        LCD_Send(LCD_Struct, 0, LCD_SETDDRAMADDR | address);
+        LCD_Struct->address = address;
+    }
+    LCD_Struct->col = col;
+    LCD_Struct->row = row;
+}
+
+/*
+ * @LCD_WriteShadow.
+ * @brief: Write a char at a position and keep the shadow in step, the lock must be taken.
+ * @return: Bytes sent, 2 when the address had to be set.
+ */
+static uint8 LCD_WriteShadow(LCD *LCD_Struct, uint8 row, uint8 col, uint8 c)
+{
+    uint8 sent = (LCD_Struct->geometry->rowOffset[row] + col == LCD_Struct->address) ? 1 : 2;
+
+    LCD_Locate(LCD_Struct, row, col);
+    LCD_Send(LCD_Struct, LCD_SEND_DATA, c);
+    LCD_Struct->address = LCD_NextAddress(LCD_Struct, LCD_Struct->address);
+    LCD_Struct->shadow[row * LCD_Struct->geometry->cols + col] = c;
+
+    return sent;
+}
+
+/*
+ * @LCD_WriteCell.
+ * @brief: Write a char at a position and keep both frames in step, the lock must be taken.
+ */
+static void LCD_WriteCell(LCD *LCD_Struct, uint8 row, uint8 col, uint8 c)
+{
+    LCD_WriteShadow(LCD_Struct, row, col, c);
+    LCD_Struct->frame[row * LCD_Struct->geometry->cols + col] = c;
+}
+
+/*
+ * @LCD_Put.
+ * @brief: Put a char on the cursor and move it forward, the lock must be taken.
+ *         After the last column the cursor goes to the next row, the address is sent with the next char.
+ */
+static void LCD_Put(LCD *LCD_Struct, uint8 c)
+{
+    LCD_WriteCell(LCD_Struct, LCD_Struct->row, LCD_Struct->col, c);
+
+    //Move cursor 1 forward
+    if(++LCD_Struct->col >= LCD_Struct->geometry->cols){
+        LCD_Struct->col = 0;
+        LCD_Struct->row = (LCD_Struct->row + 1) % LCD_Struct->geometry->rows;
+    }
+}
+
+/*
+ * @LCD_ShownCells.
+ * @brief: Cells of the shown page, or of the frame.
+ */
+static const uint8* LCD_ShownCells(const LCD *LCD_Struct)
+{
+    return (LCD_Struct->page != NULL) ? LCD_Struct->page->cells : LCD_Struct->frame;
+}
+
+/*
+ * @LCD_FlushCost.
+ * @brief: Bytes @ref LCD_FlushFrame sends to show cells, from an address counter.
+ */
+static uint32 LCD_FlushCost(const LCD *LCD_Struct, const uint8 *cells, uint8 address)
+{
+    const LCD_GEOMETRY *geometry = LCD_Struct->geometry;
+    uint32 cost = 0;
+
+    for(uint8 row = 0; row < geometry->rows; ++row){
+        for(uint8 col = 0; col < geometry->cols; ++col){
+            uint8 cell = row * geometry->cols + col;
+
+            if(cells[cell] != LCD_Struct->shadow[cell]){
+                cost += (geometry->rowOffset[row] + col == address) ? 1 : 2;
+                address = LCD_NextAddress(LCD_Struct, geometry->rowOffset[row] + col);
+            }
+        }
+    }
+    return cost;
+}
+
+/*
+ * @LCD_FlushFrame.
+ * @brief: Send the cells of the shown page, or of the frame, that differ from the shadow, the lock must be taken.
+ * @return: Bytes sent.
+ */
+static uint32 LCD_FlushFrame(LCD *LCD_Struct)
+{
+    const LCD_GEOMETRY *geometry = LCD_Struct->geometry;
+    const uint8 *cells = LCD_ShownCells(LCD_Struct);
+    uint32 sent = 0;
+
+    for(uint8 row = 0; row < geometry->rows; ++row){
+        for(uint8 col = 0; col < geometry->cols; ++col){
+            uint8 cell = row * geometry->cols + col;
+            uint8 c = cells[cell];
+
+            //The address is only sent where a run of changed cells starts.
+            if(c != LCD_Struct->shadow[cell])
+                sent += LCD_WriteShadow(LCD_Struct, row, col, c);
+        }
+    }
+    return sent;
+}
+
+/*
+ * @LCD_MarqueeChar.
+ * @brief: Char of a row of the marquee at a text position.
+ */
+static uint8 LCD_MarqueeChar(const LCD_MARQUEE *marquee, uint8 row, uint32 position)
+{
+    if((marquee->text[row] == NULL) || (marquee->length[row] == 0))
+        return ' ';
+    return marquee->text[row][position % marquee->length[row]];
+}
+
+/*
+ * @LCD_MarqueeFill.
+ * @brief: Write the text positions [from, from + count) of every row in their DDRAM columns, the lock must be taken.
+ *         Runs are streamed with the auto-increment, an address is only sent where the ring wraps.
+ *         The shadow keeps the columns that are shown once the display is back home.
+ */
+static void LCD_MarqueeFill(LCD *LCD_Struct, uint32 from, uint32 count)
+{
+    LCD_MARQUEE *marquee = LCD_Struct->marquee;
+    const LCD_GEOMETRY *geometry = LCD_Struct->geometry;
+
+    for(uint8 row = 0; row < geometry->rows; ++row){
+        for(uint32 position = from; position < from + count; ++position){
+            uint8 column = position % marquee->lineLength;
+            uint8 address = geometry->rowOffset[row] + column;
+            uint8 c = LCD_MarqueeChar(marquee, row, position);
+
+            if(address != LCD_Struct->address){
+                LCD_Send(LCD_Struct, 0, LCD_SETDDRAMADDR | address);
+                LCD_Struct->address = address;
+            }
+            LCD_Send(LCD_Struct, LCD_SEND_DATA, c);
+            LCD_Struct->address = LCD_NextAddress(LCD_Struct, LCD_Struct->address);
+            if(column < geometry->cols)
+                LCD_Struct->shadow[row * geometry->cols + column] = c;
+        }
+    }
+}
+
+/*
+ * @LCD_MarqueeRefillStale.
+ * @brief: Write the text that comes next in the columns scrolled out of the window, the lock must be taken.
+ *         The column of the position p is the one of p + lineLength.
+ */
+static void LCD_MarqueeRefillStale(LCD *LCD_Struct)
+{
+    LCD_MARQUEE *marquee = LCD_Struct->marquee;
+
+    if(marquee->stale == 0)
+        return;
+
+    LCD_MarqueeFill(LCD_Struct, marquee->position - marquee->stale + marquee->lineLength, marquee->stale);
+    marquee->refills += marquee->stale * LCD_Struct->geometry->rows;
+    marquee->stale = 0;
+}
+
+/*
+ * @LCD_FormatDigits.
+ * @brief: Write the decimal digits of value backwards from end, with a point before the last decimals digits.
+ *         At most 9 decimals, so at most 11 chars are written: 10 digits and the point, see LCD_FIELD_TEXT.
+ * @return: First char written.
+ */
+static uint8* LCD_FormatDigits(uint8 *end, uint32 value, uint8 decimals)
+{
+    uint8 digits = 0;
 
-/*********************************************************************************************************************/
-/*-------------------------------------------------------Macros------------------------------------------------------*/
-/*********************************************************************************************************************/
+    if(decimals > 9)
+        decimals = 9;
 
-/*STM Module uses to generate a delay function*/
-#define STM             &MODULE_STM0
+    //At least one digit before the point.
+    do{
+        if((decimals > 0) && (digits == decimals))
+            *--end = '.';
+        *--end = '0' + value % 10;
+        value /= 10;
+        ++digits;
+    }while((value != 0) || (digits <= decimals));
 
-/*This macro set the state of a pin
- * if arg > 0, the pin will be high
- * if arg = 0, the pin will be low
+    return end;
+}
+
+/*
+ * @LCD_FormatEng.
+ * @brief: Write value * 10^exponent with 3 significant digits and a SI prefix backwards from end.
+ * @return: First char written, NULL if the value is out of the range of the prefixes (p to T).
  */
-#define STATE(arg)  ((arg) ? IfxPort_State_high : IfxPort_State_low)
+static uint8* LCD_FormatEng(uint8 *end, uint32 value, sint8 exponent)
+{
+    static const uint8 prefixes[] = "pnum kMGT";
+    uint32 mantissa = value;
+    uint32 scale = 1;
+    sint8 top, prefix;
+    uint8 digits = 1;
 
-/*********************************************************************************************************************/
-/*-------------------------------------------------Private Variables-------------------------------------------------*/
-/*********************************************************************************************************************/
+    if(value == 0){
+        *--end = ' ';
+        *--end = '0';
+        return end;
+    }
+
+    //Number of digits, then keep the 3 leading ones rounded half up.
+    while(mantissa >= 10){
+        mantissa /= 10;
+        scale *= 10;
+        ++digits;
+    }
+    if(digits > 3){
+        mantissa = (value / (scale / 1000)) + 5;
+        mantissa /= 10;
+        if(mantissa == 1000){
+            mantissa = 100;
+            ++digits;
+        }
+    }else{
+        mantissa = value;
+        for(uint8 i = digits; i < 3; ++i){
+            mantissa *= 10;
+        }
+    }
+
+    //Exponent of the leading digit and of the prefix, the prefix is floor(top / 3).
+    top = (sint8)(digits - 1 + exponent);
+    prefix = (top >= 0) ? (top / 3) : -((2 - top) / 3);
+    if((prefix < -4) || (prefix > 4))
+        return NULL;
+
+    *--end = prefixes[prefix + 4];
+    //3 digits with 1 to 3 of them before the point.
+    return LCD_FormatDigits(end, mantissa, 2 - (top - 3 * prefix));
+}
 
 /*
- * @LCD pointer private use
- * @brief: This pointer is for private use for this file.
+ * @LCD_ResetGlyphs.
+ * @brief: Forget what is in CGRAM, its content is random at power-on.
  */
-static LCD * _LCD = NULL;
-
-/*********************************************************************************************************************/
-/*-------------------------------------------------Private Functions-------------------------------------------------*/
-/*********************************************************************************************************************/
+static void LCD_ResetGlyphs(LCD *LCD_Struct)
+{
+    memset(LCD_Struct->glyphs.slotGlyph, LCD_GLYPH_NONE, sizeof(LCD_Struct->glyphs.slotGlyph));
+    memset(LCD_Struct->glyphs.slotUse, 0, sizeof(LCD_Struct->glyphs.slotUse));
+}
 
 /*
- * @LCD_delay_ms.
- * @brief Low-level function to delay in ms.
+ * @LCD_LoadGlyph.
+ * @brief: Return the CGRAM slot of a registered glyph, uploading it to the least recently used slot
+ *         if it is not resident. The lock must be taken.
  */
-static void LCD_Delay_ms(uint32_t time_ms)
+static uint8 LCD_LoadGlyph(LCD *LCD_Struct, uint8 id)
 {
-    sint32 delay_ms = IfxStm_getTicksFromMilliseconds(STM, time_ms);
-    IfxStm_waitTicks(STM, delay_ms);
+    LCD_GLYPH_CACHE *cache = &LCD_Struct->glyphs;
+    uint8 slot = 0;
+
+    for(uint8 i = 0; i < LCD_CGRAM_SLOTS; ++i){
+        if(cache->slotGlyph[i] == id){
+            ++cache->hits;
+            cache->slotUse[i] = ++cache->useCount;
+            return i;
+        }
+        //Empty slots have slotUse 0, so they are taken first.
+        if(cache->slotUse[i] < cache->slotUse[slot])
+            slot = i;
+    }
+
+    ++cache->misses;
+    LCD_Send(LCD_Struct, 0, LCD_SETCGRAMADDR | (slot * LCD_GLYPH_ROWS));
+    for(uint8 i = 0; i < LCD_GLYPH_ROWS; ++i){
+        LCD_Send(LCD_Struct, LCD_SEND_DATA, cache->bitmap[id][i]);
+    }
+    //The address counter now points into CGRAM, the next char sets the DDRAM address again.
+    LCD_Struct->address = LCD_ADDRESS_UNKNOWN;
+
+    cache->slotGlyph[slot] = id;
+    cache->slotUse[slot] = ++cache->useCount;
+    return slot;
 }
 
 /*
- * @LCD_Enable
- * @brief: Function to enable the LCD.
+ * @LCD_GaugeGlyph.
+ * @brief: Char code of a glyph of the gauges, registered on first use. The lock must be taken.
  */
-static void LCD_Enable(void)
+static uint8 LCD_GaugeGlyph(LCD *LCD_Struct, uint8 id, const uint8 *bitmap)
 {
-    IfxPort_setPinHigh(_LCD->E->port,_LCD->E->pinIndex);
-    LCD_Delay_ms(1);
-    IfxPort_setPinLow(_LCD->E->port,_LCD->E->pinIndex);
-    LCD_Delay_ms(1);
-    IfxPort_setPinHigh(_LCD->E->port,_LCD->E->pinIndex);
+    LCD_GLYPH_CACHE *cache = &LCD_Struct->glyphs;
+
+    if(cache->bitmap[id] != bitmap){
+        cache->bitmap[id] = bitmap;
+        for(uint8 i = 0; i < LCD_CGRAM_SLOTS; ++i){
+            if(cache->slotGlyph[i] == id){
+                cache->slotGlyph[i] = LCD_GLYPH_NONE;
+                cache->slotUse[i] = 0;
+            }
+        }
+    }
+    return LCD_CGRAM_SLOTS + LCD_LoadGlyph(LCD_Struct, id);
 }
 
 /*
- * @LCD_Write_4bits.
- * @brief: Function to write 4 bits on the LCD.
+ * @LCD_InitInstance.
+ * @brief: Initialize everything but the pins of a zeroed LCD.
  */
-static void LCD_Write_4bits(uint8 data)
+static void LCD_InitInstance(LCD *LCD_Struct)
 {
-    IfxPort_setPinState(_LCD->DB7->port,_LCD->DB7->pinIndex, STATE(data & 0X08));
-    IfxPort_setPinState(_LCD->DB6->port,_LCD->DB6->pinIndex, STATE(data & 0X04));
-    IfxPort_setPinState(_LCD->DB5->port,_LCD->DB5->pinIndex, STATE(data & 0X02));
-    IfxPort_setPinState(_LCD->DB4->port,_LCD->DB4->pinIndex, STATE(data & 0X01));
-    LCD_Enable();
+    LCD_InitBus(LCD_Struct);
+
+    IfxCpu_resetSpinLock(&LCD_Struct->lock);
+    LCD_SetGeometry(LCD_Struct, &LCD_Geometry_16x2);
+    LCD_ResetGlyphs(LCD_Struct);
+
+    LCD_TIMING timing = {
+            .addressSetup_ns = LCD_TIMING_ADDRESS_SETUP_NS,
+            .enablePulse_ns = LCD_TIMING_ENABLE_PULSE_NS,
+            .enableCycle_ns = LCD_TIMING_ENABLE_CYCLE_NS,
+            .exec_us = LCD_TIMING_EXEC_US,
+            .clearHome_us = LCD_TIMING_CLEARHOME_US
+    };
+    LCD_SetTiming(LCD_Struct, &timing);
 }
 
 /*********************************************************************************************************************/
 /*---------------------------------------------Function Implementations----------------------------------------------*/
 /*********************************************************************************************************************/
 
+#if LCD_USE_HEAP
 LCD* LCD_Init(LCD_PIN *E, LCD_PIN *RS, LCD_PIN *RW,
 #ifdef MODE_8_BITS
-        LCD_PIN *DBO, LCD_PIN *DB1, LCD_PIN *DB2, LCD_PIN *DB3,
+        LCD_PIN *DB0, LCD_PIN *DB1, LCD_PIN *DB2, LCD_PIN *DB3,
 #endif
         LCD_PIN *DB4, LCD_PIN *DB5, LCD_PIN *DB6, LCD_PIN *DB7)
 {
@@ -107,110 +1097,890 @@ LCD* LCD_Init(LCD_PIN *E, LCD_PIN *RS, LCD_PIN *RW,
     ret->DB5 = DB5;
     ret->DB6 = DB6;
     ret->DB7 = DB7;
-
-    ret->col = ret->row = 0;
+    LCD_InitInstance(ret);
 
     return ret;
 }
+#endif
+
+LCD* LCD_InitStatic(LCD *storage, const LCD_Config *cfg)
+{
+    memset(storage, 0, sizeof(LCD));
+
+    storage->E = &cfg->E;
+    storage->RS = &cfg->RS;
+    storage->RW = &cfg->RW;
+    storage->DB4 = &cfg->DB4;
+    storage->DB5 = &cfg->DB5;
+    storage->DB6 = &cfg->DB6;
+    storage->DB7 = &cfg->DB7;
+    if(cfg->DB0.port != NULL){
+        storage->DB0 = &cfg->DB0;
+        storage->DB1 = &cfg->DB1;
+        storage->DB2 = &cfg->DB2;
+        storage->DB3 = &cfg->DB3;
+    }
+    LCD_InitInstance(storage);
+    if(cfg->geometry != NULL)
+        LCD_SetGeometry(storage, cfg->geometry);
+
+    return storage;
+}
+
+LCD* LCD_InitTransport(LCD *storage, const LCD_TRANSPORT *transport, void *data)
+{
+    memset(storage, 0, sizeof(LCD));
+
+    storage->transport = transport;
+    storage->transportData = data;
+    LCD_InitInstance(storage);
+
+    return storage;
+}
+
+void LCD_SetGeometry(LCD *LCD_Struct, const LCD_GEOMETRY *geometry)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    LCD_Struct->geometry = geometry;
+    LCD_Struct->col = LCD_Struct->row = 0;
+    LCD_Struct->address = LCD_ADDRESS_UNKNOWN;
+
+    //DDRAM is filled with spaces by the clear display of LCD_Begin.
+    memset(LCD_Struct->frame, ' ', sizeof(LCD_Struct->frame));
+    memset(LCD_Struct->shadow, ' ', sizeof(LCD_Struct->shadow));
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_SetTiming(LCD *LCD_Struct, const LCD_TIMING *timing)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    LCD_Struct->timing = *timing;
+
+    LCD_Struct->addressSetupTicks = LCD_TicksFromNs(timing->addressSetup_ns);
+    LCD_Struct->enableHighTicks = LCD_TicksFromNs(timing->enablePulse_ns);
+    if(timing->enableCycle_ns > timing->enablePulse_ns)
+        LCD_Struct->enableLowTicks = LCD_TicksFromNs(timing->enableCycle_ns - timing->enablePulse_ns);
+    else
+        LCD_Struct->enableLowTicks = LCD_Struct->enableHighTicks;
+    LCD_Struct->execTicks = IfxStm_getTicksFromMicroseconds(STM, timing->exec_us);
+    LCD_Struct->clearHomeTicks = IfxStm_getTicksFromMicroseconds(STM, timing->clearHome_us);
+    if(LCD_Struct->clearHomeTicks < LCD_Struct->execTicks)
+        LCD_Struct->clearHomeTicks = LCD_Struct->execTicks;
+
+    //Twice the slowest instruction before giving up on the busy flag.
+    LCD_Struct->busyTimeoutTicks = 2 * LCD_Struct->clearHomeTicks;
+
+    if(LCD_Struct->strobe != NULL)
+        LCD_StrobeTiming(LCD_Struct);
+    if(LCD_Struct->dma != NULL){
+        LCD_DmaIdle(LCD_Struct);
+        LCD_DmaTiming(LCD_Struct);
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+boolean LCD_StrobeInit(LCD *LCD_Struct, LCD_STROBE *strobe, IfxGtm_Tom_ToutMap *pin)
+{
+    IfxGtm_Tom_Pwm_Config config;
+    boolean result;
+
+    if(LCD_Struct->transport != NULL)
+        return FALSE;
+
+    IfxGtm_enable(&MODULE_GTM);
+    IfxGtm_Cmu_enableClocks(&MODULE_GTM, IFXGTM_CMU_CLKEN_FXCLK);
+
+    IfxGtm_Tom_Pwm_initConfig(&config, &MODULE_GTM);
+    config.tom = pin->tom;
+    config.tomChannel = pin->channel;
+    config.clock = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk0;
+    config.signalLevel = Ifx_ActiveState_high;
+    config.pin.outputPin = pin;
+    config.pin.outputMode = IfxPort_OutputMode_pushPull;
+    //Period and duty cycle are loaded by LCD_StrobeTiming, until then the output stays low.
+    config.period = 0;
+    config.dutyCycle = 0;
+    config.immediateStartEnabled = TRUE;
+
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+
+    //IfxGtm_Tom_Pwm_init does not apply oneShotModeEnabled, so it is set on the channel directly.
+    IfxGtm_Tom_Ch_setOneShotMode(&MODULE_GTM.TOM[pin->tom], pin->channel, TRUE);
+    result = IfxGtm_Tom_Pwm_init(&strobe->tom, &config);
+    if(result){
+        LCD_Struct->strobe = strobe;
+        LCD_StrobeTiming(LCD_Struct);
+    }
+    LCD_Unlock(LCD_Struct);
+
+    return result;
+}
+
+boolean LCD_DmaInit(LCD *LCD_Struct, LCD_DMA *dma, IfxDma_ChannelId channel, IfxGtm_Tom tom, IfxGtm_Tom_Ch tomChannel)
+{
+    IfxGtm_Tom_Pwm_Config tickConfig;
+    IfxDma_Dma_ChannelConfig *config = &dma->config;
+    uint8 e = LCD_Struct->E->pinIndex;
+    uint8 rs = LCD_Struct->RS->pinIndex;
+
+    if((LCD_Struct->transport != NULL) || (LCD_Struct->async != NULL) || (LCD_Struct->strobe != NULL))
+        return FALSE;
+
+    IfxGtm_enable(&MODULE_GTM);
+    IfxGtm_Cmu_enableClocks(&MODULE_GTM, IFXGTM_CMU_CLKEN_FXCLK);
+
+    //Each period of the TOM channel routes a request to the DMA channel: type of service DMA, priority = channel.
+    IfxGtm_Tom_Pwm_initConfig(&tickConfig, &MODULE_GTM);
+    tickConfig.tom = tom;
+    tickConfig.tomChannel = tomChannel;
+    tickConfig.clock = IfxGtm_Tom_Ch_ClkSrc_cmuFxclk0;
+    tickConfig.pin.outputPin = NULL_PTR;
+    tickConfig.period = 0;
+    tickConfig.dutyCycle = 0;
+    tickConfig.immediateStartEnabled = FALSE;
+    tickConfig.interrupt.ccu0Enabled = TRUE;
+    tickConfig.interrupt.mode = IfxGtm_IrqMode_pulseNotify;
+    tickConfig.interrupt.isrProvider = IfxSrc_Tos_dma;
+    tickConfig.interrupt.isrPriority = (Ifx_Priority)channel;
+    if(!IfxGtm_Tom_Pwm_init(&dma->tick, &tickConfig))
+        return FALSE;
+    IfxGtm_Tom_Tgc_enableChannel(dma->tick.tgc[0], tomChannel, FALSE, TRUE);
+
+    dma->stopWord = IfxGtm_Tom_Tgc_buildFeatureForChannel(tomChannel, FALSE, IFX_GTM_TOM_TGC0_ENDIS_CTRL_ENDIS_CTRL0_OFF);
+    dma->enabledWord = IfxGtm_Tom_Tgc_buildFeatureForChannel(tomChannel, TRUE, IFX_GTM_TOM_TGC0_ENDIS_CTRL_ENDIS_CTRL0_OFF);
+    dma->eWords[0] = 1UL << e;
+    dma->eWords[1] = 1UL << (e + 16);
+    dma->rsWords[0] = 1UL << (rs + 16);
+    dma->rsWords[1] = 1UL << rs;
+
+    //One 32 bit move per request, from consecutive words (or a single one repeated) to the same OMR.
+    IfxDma_Dma_createModuleHandle(&dma->module, &MODULE_DMA);
+    IfxDma_Dma_initChannelConfig(config, &dma->module);
+    config->channelId = channel;
+    config->moveSize = IfxDma_ChannelMoveSize_32bit;
+    config->blockMode = IfxDma_ChannelMove_1;
+    config->requestMode = IfxDma_ChannelRequestMode_oneTransferPerRequest;
+    config->operationMode = IfxDma_ChannelOperationMode_continuous;
+    config->hardwareRequestEnabled = TRUE;
+    config->sourceAddressIncrementStep = IfxDma_ChannelIncrementStep_1;
+    config->sourceAddressIncrementDirection = IfxDma_ChannelIncrementDirection_positive;
+    config->sourceAddressCircularRange = IfxDma_ChannelIncrementCircular_4;
+    config->destinationCircularBufferEnabled = TRUE;
+    config->destinationAddressCircularRange = IfxDma_ChannelIncrementCircular_none;
+    config->shadowControl = IfxDma_ChannelShadow_linkedList;
+    config->channelInterruptEnabled = FALSE;
+
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    LCD_WaitReady(LCD_Struct);
+    dma->entries = dma->wordCount = 0;
+    dma->running = FALSE;
+    dma->runs = dma->maxEntries = 0;
+    //The list starts by writing RS, so the pin state is known.
+    LCD_Struct->rsState = 0XFF;
+    LCD_Struct->dma = dma;
+    LCD_DmaTiming(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
+
+    return TRUE;
+}
+
+boolean LCD_DmaIsBusy(LCD *LCD_Struct)
+{
+    LCD_DMA *dma = LCD_Struct->dma;
+
+    //The last transaction set disables the TOM channel, then no transfer of the channel is left.
+    if(dma->running && ((dma->tick.tgc[0]->ENDIS_STAT.U & dma->enabledWord) == 0)
+            && (IfxDma_getChannelTransferCount(dma->channel.dma, dma->channel.channelId) == 0))
+        dma->running = FALSE;
+
+    return dma->running;
+}
+
+void LCD_DmaWait(LCD *LCD_Struct)
+{
+    while(LCD_DmaIsBusy(LCD_Struct))
+    {}
+}
+
+void LCD_SetBusyFlagMode(LCD *LCD_Struct, boolean enable)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+
+    //Let the last instruction finish before changing the way of waiting.
+    LCD_WaitReady(LCD_Struct);
+    LCD_Struct->useBusyFlag = enable;
+    LCD_Unlock(LCD_Struct);
+}
+
+boolean LCD_AsyncInit(LCD *LCD_Struct, LCD_ASYNC *async, Ifx_STM *stm, IfxStm_Comparator comparator,
+        Ifx_Priority priority, IfxSrc_Tos typeOfService)
+{
+    IfxStm_CompareConfig config;
+
+    async->stm = stm;
+    async->comparator = comparator;
+    async->fifo = Ifx_Fifo_initSpsc(async->fifoBuffer, 2 * LCD_ASYNC_QUEUE_LENGTH, 2);
+    async->busy = FALSE;
+    async->lock = 0;
+    async->exchanging = FALSE;
+    async->maxDepth = async->overruns = 0;
+    async->drainStart = async->lastDrainTicks = async->maxDrainTicks = 0;
+
+    IfxStm_initCompareConfig(&config);
+    config.comparator = comparator;
+    config.comparatorInterrupt = (comparator == IfxStm_Comparator_0) ? IfxStm_ComparatorInterrupt_ir0 : IfxStm_ComparatorInterrupt_ir1;
+    config.triggerPriority = priority;
+    config.typeOfService = typeOfService;
+    if(!IfxStm_initCompare(stm, &config))
+        return FALSE;
+
+    //Queue from now on, once the synchronous transfers are over.
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    LCD_WaitReady(LCD_Struct);
+    LCD_Struct->async = async;
+    LCD_Unlock(LCD_Struct);
+
+    return TRUE;
+}
+
+void LCD_AsyncIsr(LCD *LCD_Struct)
+{
+    LCD_ASYNC *async = LCD_Struct->async;
+    uint8 transfer[2];
+    uint32 now;
+    boolean interruptState;
+
+    IfxStm_clearCompareFlag(async->stm, async->comparator);
+    if(!async->busy)
+        return;
+
+    //The exchange started by the previous match is polled, the interrupt never waits for the transport.
+    if(async->exchanging){
+        now = IfxStm_getLower(async->stm);
+        if((LCD_Struct->transport->isBusy != NULL) && LCD_Struct->transport->isBusy(LCD_Struct)){
+            IfxStm_updateCompare(async->stm, async->comparator, now + LCD_Struct->execTicks);
+            return;
+        }
+        async->exchanging = FALSE;
+        //As in LCD_Send, clear and home are waited once the transport has really sent them.
+        if(async->exchangeFlags & LCD_SEND_LONG){
+            IfxStm_updateCompare(async->stm, async->comparator, now + LCD_Struct->clearHomeTicks);
+            return;
+        }
+    }
+
+    //The queue is found empty and busy cleared in one step, so a push cannot slip in between unseen.
+    interruptState = LCD_AsyncHandshake(async);
+    if(Ifx_Fifo_read(async->fifo, transfer, sizeof(transfer), TIME_NULL) != 0){
+        //Queue empty, the last transfer has been executed.
+        async->lastDrainTicks = IfxStm_getLower(async->stm) - async->drainStart;
+        if(async->lastDrainTicks > async->maxDrainTicks)
+            async->maxDrainTicks = async->lastDrainTicks;
+        async->busy = FALSE;
+        IfxCpu_resetSpinLock(&async->lock);
+        IfxCpu_restoreInterrupts(interruptState);
+        return;
+    }
+    IfxCpu_resetSpinLock(&async->lock);
+    IfxCpu_restoreInterrupts(interruptState);
+
+    //No lock here, in asynchronous mode only this interrupt drives the pins.
+    LCD_Write_byte(LCD_Struct, transfer[0], transfer[1]);
+    now = IfxStm_getLower(async->stm);
+    if(LCD_Struct->transport != NULL){
+        LCD_Struct->transport->flush(LCD_Struct);
+        async->exchanging = TRUE;
+        async->exchangeFlags = transfer[0];
+        IfxStm_updateCompare(async->stm, async->comparator, now + LCD_Struct->execTicks);
+        return;
+    }
+    IfxStm_updateCompare(async->stm, async->comparator,
+            now + ((transfer[0] & LCD_SEND_LONG) ? LCD_Struct->clearHomeTicks : LCD_Struct->execTicks));
+}
+
+void LCD_AsyncWait(LCD *LCD_Struct)
+{
+    while(LCD_Struct->async->busy)
+    {}
+}
 
 void LCD_Begin(LCD *LCD_Struct)
 {
-    _LCD = LCD_Struct;
+    LCD_BeginStart(LCD_Struct);
+    while(!LCD_BeginPoll(LCD_Struct))
+    {}
+}
+
+void LCD_BeginStart(LCD *LCD_Struct)
+{
+    uint64 powerOn = IfxStm_getTicksFromMicroseconds(STM, LCD_TIMING_POWERON_US);
+
+    LCD_Lock(LCD_Struct, LCD_Call_begin);
+    //The reset sequence is written on the bus directly, the transmit queue must be empty.
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+    if(LCD_Struct->dma != NULL)
+        LCD_DmaIdle(LCD_Struct);
 
     //Keep Enable pin low.
-    IfxPort_setPinLow(LCD_Struct->E->port, LCD_Struct->E->pinIndex);
-    IfxPort_setPinLow(LCD_Struct->RS->port, LCD_Struct->RS->pinIndex);
-    IfxPort_setPinLow(LCD_Struct->RW->port, LCD_Struct->RW->pinIndex);
-    LCD_Delay_ms(10);
+    if(LCD_Struct->transport == NULL){
+        IfxPort_setPinLow(LCD_Struct->E->port, LCD_Struct->E->pinIndex);
+        IfxPort_setPinLow(LCD_Struct->RS->port, LCD_Struct->RS->pinIndex);
+        IfxPort_setPinLow(LCD_Struct->RW->port, LCD_Struct->RW->pinIndex);
+        LCD_SetDataBusInput(LCD_Struct, FALSE);
+    }
+    LCD_Struct->rsState = 0;
+
+    //The STM starts with the reset, so after a long startup there is nothing left to wait.
+    LCD_Struct->initStartTime = IfxStm_get(STM);
+    LCD_Struct->initDeadline = (LCD_Struct->initStartTime > powerOn) ? LCD_Struct->initStartTime : powerOn;
+    LCD_Struct->readyTime = 0;
+    LCD_Struct->initStep = LCD_InitStep_powerOn;
+    LCD_Unlock(LCD_Struct);
+}
 
-    //Function set config.
-    LCD_Send_command(LCD_FUNCTIONSET | LCD_FUNCTION_LENGTH_4 | LCD_FUNCTION_LINES_2 | LCD_FUNCTION_FONT_5X8);
-    LCD_Delay_ms(5);
+boolean LCD_BeginPoll(LCD *LCD_Struct)
+{
+    uint8 length = LCD_Struct->mode8Bits ? LCD_FUNCTION_LENGTH_8 : LCD_FUNCTION_LENGTH_4;
+    uint32 wait = LCD_Struct->execTicks;
+    uint64 now;
 
-    //Display on/off, cursor blink config.
-    LCD_Send_command(LCD_DISPLAYONOFFCTRL | LCD_ONOFF_DISPLAY_ON | LCD_ONOFF_CURSORBLINK_ON | LCD_ONOFF_CURSOR_ON);
-    LCD_Delay_ms(5);
+    if(LCD_Struct->initStep == LCD_InitStep_ready)
+        return TRUE;
 
-    //Entry mode congig.
-    LCD_Send_command(LCD_ENTRYMODESET | LCD_ENTRY_RIGHT | LCD_SHIFT_CURSOR_LEFT);
-    LCD_Delay_ms(5);
+    LCD_Lock(LCD_Struct, LCD_Call_begin);
+    now = IfxStm_get(STM);
+    //The busy flag can be checked once the function set has been sent, until then only the times are waited.
+    if(LCD_Struct->useBusyFlag && (LCD_Struct->initStep > LCD_InitStep_functionSet)){
+        if(LCD_Read_byte(LCD_Struct, IfxPort_State_low) & LCD_BUSYFLAG){
+            if(now < LCD_Struct->initDeadline){
+                LCD_Unlock(LCD_Struct);
+                return FALSE;
+            }
+            LCD_Struct->useBusyFlag = FALSE;
+            ++LCD_Struct->busyTimeouts;
+        }
+    }
+    else if(now < LCD_Struct->initDeadline){
+        LCD_Unlock(LCD_Struct);
+        return FALSE;
+    }
 
-    LCD_ClearScreen(LCD_Struct);
+    switch(LCD_Struct->initStep){
+    case LCD_InitStep_powerOn:
+        //Initialization by instruction: 8 bits function set three times, whatever mode the LCD was left in.
+        LCD_Write_nibble(LCD_Struct, LCD_FUNCTIONSET | LCD_FUNCTION_LENGTH_8);
+        wait = IfxStm_getTicksFromMicroseconds(STM, LCD_TIMING_RESET1_US);
+        break;
+    case LCD_InitStep_reset2:
+        LCD_Write_nibble(LCD_Struct, LCD_FUNCTIONSET | LCD_FUNCTION_LENGTH_8);
+        wait = IfxStm_getTicksFromMicroseconds(STM, LCD_TIMING_RESET2_US);
+        break;
+    case LCD_InitStep_reset3:
+        LCD_Write_nibble(LCD_Struct, LCD_FUNCTIONSET | LCD_FUNCTION_LENGTH_8);
+        //In 8 bits mode there is no bus width switch.
+        if(LCD_Struct->mode8Bits)
+            ++LCD_Struct->initStep;
+        break;
+    case LCD_InitStep_busWidth:
+        //A single nibble switches to 4 bits mode, the next function set is sent as 2 nibbles.
+        LCD_Write_nibble(LCD_Struct, LCD_FUNCTIONSET | LCD_FUNCTION_LENGTH_4);
+        break;
+    case LCD_InitStep_functionSet:
+        LCD_Write_byte(LCD_Struct, 0, LCD_FUNCTIONSET | length | LCD_FUNCTION_FONT_5X8 |
+                ((LCD_Struct->geometry->rows > 1) ? LCD_FUNCTION_LINES_2 : LCD_FUNCTION_LINES_1));
+        break;
+    case LCD_InitStep_displayControl:
+        LCD_Write_byte(LCD_Struct, 0, LCD_DISPLAYONOFFCTRL | LCD_ONOFF_DISPLAY_ON | LCD_ONOFF_CURSORBLINK_ON | LCD_ONOFF_CURSOR_ON);
+        break;
+    case LCD_InitStep_entryMode:
+        LCD_Write_byte(LCD_Struct, 0, LCD_ENTRYMODESET | LCD_ENTRY_RIGHT | LCD_SHIFT_CURSOR_LEFT);
+        break;
+    case LCD_InitStep_clear:
+        //Clear display also returns home.
+        LCD_Write_byte(LCD_Struct, 0, LCD_CLEARDISPLAY);
+        wait = LCD_Struct->clearHomeTicks;
+        break;
+    default:
+        LCD_Struct->col = 0;
+        LCD_Struct->row = 0;
+        LCD_Struct->address = 0;
+        memset(LCD_Struct->frame, ' ', sizeof(LCD_Struct->frame));
+        memset(LCD_Struct->shadow, ' ', sizeof(LCD_Struct->shadow));
+        LCD_ResetGlyphs(LCD_Struct);
+        LCD_Struct->readyTime = now;
+        LCD_Struct->initStep = LCD_InitStep_ready;
+        LCD_Unlock(LCD_Struct);
+        LCD_READY_HOOK(LCD_Struct);
+        return TRUE;
+    }
 
-    LCD_Home(LCD_Struct);
+    //In busy flag mode the deadline is the timeout of the busy flag.
+    if(LCD_Struct->useBusyFlag && (LCD_Struct->initStep >= LCD_InitStep_functionSet))
+        wait = LCD_Struct->busyTimeoutTicks;
+    //The wait starts once a transport has really sent the instruction.
+    if(LCD_Struct->transport != NULL)
+        LCD_TransportSync(LCD_Struct);
+    LCD_Struct->initDeadline = IfxStm_get(STM) + wait;
+    ++LCD_Struct->initStep;
+    LCD_Unlock(LCD_Struct);
+    return FALSE;
+}
 
-    LCD_Delay_ms(500);
+uint64 LCD_GetInitTime(LCD *LCD_Struct)
+{
+    if(LCD_Struct->initStep != LCD_InitStep_ready)
+        return 0;
+    return LCD_Struct->readyTime - LCD_Struct->initStartTime;
 }
 
 void LCD_ClearScreen(LCD *LCD_Struct)
 {
-    _LCD = LCD_Struct;
-    LCD_Send_command(LCD_CLEARDISPLAY);
-    LCD_Delay_ms(1);
+    LCD_Lock(LCD_Struct, LCD_Call_clear);
+    if(LCD_Reserve(LCD_Struct, 1))
+        LCD_Clear(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
 }
 
 void LCD_Home(LCD *LCD_Struct)
 {
-    _LCD = LCD_Struct;
-    LCD_Send_command(LCD_RETURNHOME);
-    LCD_Delay_ms(1);
-    LCD_Struct->col = 0;
-    LCD_Struct->row = 0;
+    LCD_Lock(LCD_Struct, LCD_Call_clear);
+    if(LCD_Reserve(LCD_Struct, 1))
+        LCD_ReturnHome(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
 }
 
 void LCD_SetCursor(LCD *LCD_Struct, uint8 row, uint8 col)
 {
-    _LCD = LCD_Struct;
-    uint8 temp_col;
-    col = col % 16;
-    temp_col = col;
-    if(row == 1)
-        temp_col += 0x40;
-
-    LCD_Send_command(LCD_SETDDRAMADDR | temp_col);
-    LCD_Delay_ms(1);
-    LCD_Struct->col = col;
-    LCD_Struct->row = row;
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    if(LCD_Reserve(LCD_Struct, 1))
+        LCD_Locate(LCD_Struct, row % LCD_Struct->geometry->rows, col % LCD_Struct->geometry->cols);
+    LCD_Unlock(LCD_Struct);
 }
 
 void LCD_PutChar(LCD *LCD_Struct, uint8 c)
 {
-    _LCD = LCD_Struct;
-    LCD_Send_data(c);
-    LCD_Delay_ms(1);
-
-    //Move cursor 1 forward
-    if((LCD_Struct->row == 0) && (LCD_Struct->col == 15))
-        LCD_SetCursor(LCD_Struct, 1, 0);
-    if((LCD_Struct->row == 1) && (LCD_Struct->col == 15))
-        LCD_SetCursor(LCD_Struct, 0, 0);
-    else
-        LCD_SetCursor(LCD_Struct, LCD_Struct->row, LCD_Struct->col + 1);
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    //The address and the char.
+    if(LCD_Reserve(LCD_Struct, 2))
+        LCD_Put(LCD_Struct, c);
+    LCD_Unlock(LCD_Struct);
 }
 
 void LCD_PutStr(LCD *LCD_Struct, uint8 *s)
 {
-    _LCD = LCD_Struct;
+    uint32 len = strlen((const char *)s);
+
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    //An address where the text starts and at each row change.
+    if(LCD_Reserve(LCD_Struct, len + len / LCD_Struct->geometry->cols + 2)){
+        for(; *s != 0; ++s){
+            LCD_Put(LCD_Struct, *s);
+        }
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_WriteRun(LCD *LCD_Struct, uint8 row, uint8 col, const uint8 *buf, uint32 len)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    if(LCD_Reserve(LCD_Struct, len + len / LCD_Struct->geometry->cols + 2)){
+        LCD_Struct->row = row % LCD_Struct->geometry->rows;
+        LCD_Struct->col = col % LCD_Struct->geometry->cols;
+        while(len-- > 0){
+            LCD_Put(LCD_Struct, *buf++);
+        }
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_RegisterGlyph(LCD *LCD_Struct, uint8 id, const uint8 *bitmap)
+{
+    if(id >= LCD_MAX_GLYPHS)
+        return;
+
+    LCD_Lock(LCD_Struct, LCD_Call_glyph);
+    LCD_Struct->glyphs.bitmap[id] = bitmap;
+    for(uint8 i = 0; i < LCD_CGRAM_SLOTS; ++i){
+        if(LCD_Struct->glyphs.slotGlyph[i] == id){
+            LCD_Struct->glyphs.slotGlyph[i] = LCD_GLYPH_NONE;
+            LCD_Struct->glyphs.slotUse[i] = 0;
+        }
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+uint8 LCD_UseGlyph(LCD *LCD_Struct, uint8 id)
+{
+    uint8 c = ' ';
+
+    if((id >= LCD_MAX_GLYPHS) || (LCD_Struct->glyphs.bitmap[id] == NULL))
+        return c;
+
+    LCD_Lock(LCD_Struct, LCD_Call_glyph);
+    //Char codes 0X08-0X0F mirror the CGRAM slots and, unlike 0X00, can be used inside strings.
+    if(LCD_Reserve(LCD_Struct, 1 + LCD_GLYPH_ROWS))
+        c = LCD_CGRAM_SLOTS + LCD_LoadGlyph(LCD_Struct, id);
+    LCD_Unlock(LCD_Struct);
+    return c;
+}
+
+void LCD_PutGlyph(LCD *LCD_Struct, uint8 id)
+{
+    LCD_PutChar(LCD_Struct, LCD_UseGlyph(LCD_Struct, id));
+}
+
+void LCD_PrintGlyph(LCD *LCD_Struct, uint8 row, uint8 col, uint8 id)
+{
+    LCD_PrintChar(LCD_Struct, row, col, LCD_UseGlyph(LCD_Struct, id));
+}
+
+void LCD_PrintBar(LCD *LCD_Struct, uint8 row, uint8 col, uint8 width, uint32 value, uint32 max)
+{
+    uint32 level;
+
+    if(max == 0)
+        return;
+    if(value > max)
+        value = max;
+    level = (uint32)(((uint64)value * width * 5 + max / 2) / max);
+
+    LCD_Lock(LCD_Struct, LCD_Call_glyph);
+    //A bar uses the full glyph and at most one partial glyph.
+    if(!LCD_Reserve(LCD_Struct, 2 * (1 + LCD_GLYPH_ROWS))){
+        LCD_Unlock(LCD_Struct);
+        return;
+    }
+    for(uint8 i = 0; i < width; ++i, level = (level > 5) ? level - 5 : 0){
+        uint8 step = (level > 5) ? 5 : (uint8)level;
+        uint8 c = ' ';
+
+        if(step > 0)
+            c = LCD_GaugeGlyph(LCD_Struct, LCD_GLYPH_BAR + step - 1, LCD_BarGlyphs[step - 1]);
+        LCD_PrintChar(LCD_Struct, row, col + i, c);
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_PrintBigNumber(LCD *LCD_Struct, uint8 row, uint8 col, uint8 digits, uint32 value)
+{
+    uint8 codes[3];
+
+    LCD_Lock(LCD_Struct, LCD_Call_glyph);
+    if(!LCD_Reserve(LCD_Struct, 3 * (1 + LCD_GLYPH_ROWS))){
+        LCD_Unlock(LCD_Struct);
+        return;
+    }
+    for(uint8 i = 0; i < 3; ++i){
+        codes[i] = LCD_GaugeGlyph(LCD_Struct, LCD_GLYPH_BIG + i, LCD_BigGlyphs[i]);
+    }
+
+    //From the last digit backwards, leading zeros are left blank.
+    for(uint8 d = digits; d > 0; --d, value /= 10){
+        uint8 x = col + 4 * (d - 1);
+        boolean blank = (value == 0) && (d != digits);
+
+        for(uint8 r = 0; r < 2; ++r){
+            for(uint8 i = 0; i < 4; ++i){
+                char stroke = (blank || (i == 3)) ? ' ' : LCD_BigDigits[value % 10][r][i];
+                uint8 c = ' ';
+
+                if(stroke == 'F')
+                    c = 0XFF;
+                else if(stroke == 'U')
+                    c = codes[0];
+                else if(stroke == 'L')
+                    c = codes[1];
+                else if(stroke == 'B')
+                    c = codes[2];
+                LCD_PrintChar(LCD_Struct, row + r, x + i, c);
+            }
+        }
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_PrintChar(LCD *LCD_Struct, uint8 row, uint8 col, uint8 c)
+{
+    if((row < LCD_Struct->geometry->rows) && (col < LCD_Struct->geometry->cols))
+        LCD_Struct->frame[row * LCD_Struct->geometry->cols + col] = c;
+}
+
+void LCD_Print(LCD *LCD_Struct, uint8 row, uint8 col, const uint8 *s)
+{
+    for(; (*s != 0) && (col < LCD_Struct->geometry->cols); ++s, ++col){
+        LCD_PrintChar(LCD_Struct, row, col, *s);
+    }
+}
+
+void LCD_PrintField(LCD *LCD_Struct, uint8 row, uint8 col, uint8 width, sint32 value, uint16 format)
+{
+    uint8 text[LCD_FIELD_TEXT];
+    uint8 *end = &text[sizeof(text)];
+    uint8 *start;
+    uint8 sign = 0;
+    uint32 magnitude = (value < 0) ? 0U - (uint32)value : (uint32)value;
+    uint8 option = (format >> 4) & 0X0F;
+    uint8 length, pad;
+
+    if(width > 16)
+        width = 16;
+
+    switch(format & 0X000F){
+    case 0X0002:
+        start = end;
+        magnitude = (uint32)value;
+        do{
+            *--start = "0123456789ABCDEF"[magnitude & 0X0F];
+            magnitude >>= 4;
+        }while(magnitude != 0);
+        break;
+    case 0X0003:
+        start = LCD_FormatEng(end, magnitude, (sint8)(3 * (option - 4)));
+        break;
+    case 0X0001:
+        start = LCD_FormatDigits(end, magnitude, option);
+        break;
+    default:
+        start = LCD_FormatDigits(end, magnitude, 0);
+        break;
+    }
+    if((format & 0X000F) != 0X0002){
+        if(value < 0)
+            sign = '-';
+        else if(format & LCD_FIELD_PLUS)
+            sign = '+';
+    }
+
+    //Out of the prefixes, or too long for the field.
+    length = (start != NULL) ? (uint8)(end - start) + (sign ? 1 : 0) : 0XFF;
+    if(length > width){
+        for(uint8 i = 0; i < width; ++i){
+            LCD_PrintChar(LCD_Struct, row, col + i, '#');
+        }
+        return;
+    }
+
+    //Spaces go before the sign, zeros after it.
+    pad = width - length;
+    if(!(format & LCD_FIELD_ZEROPAD)){
+        for(; pad > 0; --pad){
+            LCD_PrintChar(LCD_Struct, row, col++, ' ');
+        }
+    }
+    if(sign)
+        LCD_PrintChar(LCD_Struct, row, col++, sign);
+    for(; pad > 0; --pad){
+        LCD_PrintChar(LCD_Struct, row, col++, '0');
+    }
+    while(start < end){
+        LCD_PrintChar(LCD_Struct, row, col++, *start++);
+    }
+}
+
+void LCD_PrintClear(LCD *LCD_Struct)
+{
+    memset(LCD_Struct->frame, ' ', sizeof(LCD_Struct->frame));
+}
+
+void LCD_Flush(LCD *LCD_Struct)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    //The shifted display does not show the frame, it is sent by LCD_MarqueeStop.
+    //A dropped flush is sent by the next one, the cells still differ from the shadow.
+    if((LCD_Struct->marquee == NULL) && ((LCD_Struct->async == NULL)
+            || LCD_Reserve(LCD_Struct, LCD_FlushCost(LCD_Struct, LCD_ShownCells(LCD_Struct), LCD_Struct->address))))
+        LCD_FlushFrame(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_PageClear(LCD_PAGE *page)
+{
+    memset(page->cells, ' ', sizeof(page->cells));
+}
+
+void LCD_PagePrintChar(LCD *LCD_Struct, LCD_PAGE *page, uint8 row, uint8 col, uint8 c)
+{
+    const LCD_GEOMETRY *geometry = LCD_Struct->geometry;
+
+    if((row >= geometry->rows) || (col >= geometry->cols))
+        return;
+    page->cells[row * geometry->cols + col] = c;
+}
+
+void LCD_PagePrint(LCD *LCD_Struct, LCD_PAGE *page, uint8 row, uint8 col, const uint8 *s)
+{
+    for(; (*s != 0) && (col < LCD_Struct->geometry->cols); ++s, ++col){
+        LCD_PagePrintChar(LCD_Struct, page, row, col, *s);
+    }
+}
+
+void LCD_ShowPage(LCD *LCD_Struct, LCD_PAGE *page)
+{
+    const LCD_GEOMETRY *geometry;
+    uint32 sent;
+
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    if((LCD_Struct->marquee == NULL) && (LCD_Struct->async != NULL)
+            && !LCD_Reserve(LCD_Struct, LCD_FlushCost(LCD_Struct, page->cells, LCD_Struct->address))){
+        LCD_Unlock(LCD_Struct);
+        return;
+    }
+    LCD_Struct->page = page;
+    if(LCD_Struct->marquee == NULL){
+        geometry = LCD_Struct->geometry;
+        sent = LCD_FlushFrame(LCD_Struct);
+
+        //A full redraw is a data byte per cell and an address per row.
+        ++LCD_Struct->pageFlips;
+        LCD_Struct->pageBytesSent += sent;
+        LCD_Struct->pageBytesSaved += geometry->rows * (geometry->cols + 1) - sent;
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+boolean LCD_MarqueeStart(LCD *LCD_Struct, LCD_MARQUEE *marquee, const uint8 *text0, const uint8 *text1)
+{
+    const LCD_GEOMETRY *geometry = LCD_Struct->geometry;
+    uint8 lineLength = (geometry->rows == 1) ? 80 : 40;
 
-    for(; *s != 0; ++s){
-        LCD_PutChar(LCD_Struct, *s);
+    //Rows sharing a DDRAM line (20x4) or without hidden columns (40x2) can not be scrolled alone.
+    if((geometry->rows > 2) || (geometry->cols >= lineLength))
+        return FALSE;
+
+    //Return home, then each row and an address per row and where the ring wraps.
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    if(!LCD_Reserve(LCD_Struct, 1 + geometry->rows * (lineLength + 2))){
+        LCD_Unlock(LCD_Struct);
+        return FALSE;
+    }
+
+    marquee->text[0] = text0;
+    marquee->text[1] = text1;
+    marquee->length[0] = (text0 != NULL) ? strlen((const char *)text0) : 0;
+    marquee->length[1] = (text1 != NULL) ? strlen((const char *)text1) : 0;
+    marquee->lineLength = lineLength;
+    marquee->position = 0;
+    marquee->stale = 0;
+    marquee->steps = 0;
+    marquee->refills = 0;
+
+    LCD_ReturnHome(LCD_Struct);
+    LCD_Struct->marquee = marquee;
+    LCD_MarqueeFill(LCD_Struct, 0, lineLength);
+    LCD_Unlock(LCD_Struct);
+
+    return TRUE;
+}
+
+void LCD_MarqueeStep(LCD *LCD_Struct)
+{
+    LCD_MARQUEE *marquee;
+
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    marquee = LCD_Struct->marquee;
+    if((marquee != NULL) && LCD_Reserve(LCD_Struct, 1 + LCD_Struct->geometry->rows * (marquee->stale + 2))){
+        //The window may only reach the columns refilled since the preload.
+        if(marquee->stale >= marquee->lineLength - LCD_Struct->geometry->cols)
+            LCD_MarqueeRefillStale(LCD_Struct);
+        LCD_Send(LCD_Struct, 0, LCD_CURSORDISPLAYSHIFT | LCD_SHIFT_DISPLAY_LEFT);
+        ++marquee->position;
+        ++marquee->stale;
+        ++marquee->steps;
+    }
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_MarqueeRefill(LCD *LCD_Struct)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    if((LCD_Struct->marquee != NULL) && LCD_Reserve(LCD_Struct, LCD_Struct->geometry->rows * (LCD_Struct->marquee->stale + 2)))
+        LCD_MarqueeRefillStale(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
+}
+
+void LCD_MarqueeStop(LCD *LCD_Struct)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_frame);
+    if((LCD_Struct->marquee != NULL) && ((LCD_Struct->async == NULL)
+            || LCD_Reserve(LCD_Struct, 1 + LCD_FlushCost(LCD_Struct, LCD_ShownCells(LCD_Struct), 0)))){
+        LCD_ReturnHome(LCD_Struct);
+        LCD_FlushFrame(LCD_Struct);
     }
+    LCD_Unlock(LCD_Struct);
 }
 
-void LCD_Send_command(uint8 cmd)
+#if LCD_USE_STATS
+void LCD_StatsReset(LCD *LCD_Struct)
 {
-    IfxPort_setPinState(_LCD->RS->port, _LCD->RS->pinIndex, IfxPort_State_low);
-    IfxPort_setPinState(_LCD->RW->port, _LCD->RW->pinIndex, IfxPort_State_low);
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    memset(&LCD_Struct->stats, 0, sizeof(LCD_STATS));
+    LCD_Struct->stats.call = LCD_Call_setup;
+    LCD_Struct->stats.start = IfxCpu_getClockCounter();
+    LCD_Unlock(LCD_Struct);
+}
+#endif
+
+uint8 LCD_ReadAddressCounter(LCD *LCD_Struct)
+{
+    uint8 address;
+
+    LCD_Lock(LCD_Struct, LCD_Call_read);
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+    if(LCD_Struct->dma != NULL)
+        LCD_DmaIdle(LCD_Struct);
+    LCD_WaitReady(LCD_Struct);
+
+    //The address counter is updated shortly after the busy flag clears, so read it again.
+    address = LCD_Read_byte(LCD_Struct, IfxPort_State_low) & LCD_ADDRESSCOUNTER_MASK;
+    LCD_Struct->address = address;
+    LCD_Unlock(LCD_Struct);
+
+    return address;
+}
 
-    LCD_Write_4bits(cmd>>4);
-    LCD_Write_4bits(cmd);
+uint8 LCD_ReadData(LCD *LCD_Struct)
+{
+    uint8 data;
+
+    LCD_Lock(LCD_Struct, LCD_Call_read);
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+    if(LCD_Struct->dma != NULL)
+        LCD_DmaIdle(LCD_Struct);
+    LCD_WaitReady(LCD_Struct);
+
+    data = LCD_Read_byte(LCD_Struct, IfxPort_State_high);
+    LCD_Struct->address = LCD_NextAddress(LCD_Struct, LCD_Struct->address);
+    if(!LCD_Struct->useBusyFlag)
+        IfxStm_waitTicks(STM, LCD_Struct->execTicks);
+    LCD_Unlock(LCD_Struct);
+
+    return data;
 }
 
-void LCD_Send_data(uint8 data)
+void LCD_Send_command(LCD *LCD_Struct, uint8 cmd)
 {
-    IfxPort_setPinState(_LCD->RS->port, _LCD->RS->pinIndex, IfxPort_State_high);
-    IfxPort_setPinState(_LCD->RW->port, _LCD->RW->pinIndex, IfxPort_State_low);
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    if(LCD_Reserve(LCD_Struct, 1)){
+        LCD_Send(LCD_Struct, 0, cmd);
+        //Any command may move the address counter.
+        LCD_Struct->address = LCD_ADDRESS_UNKNOWN;
+    }
+    LCD_Unlock(LCD_Struct);
+}
 
-    LCD_Write_4bits(data>>4);
-    LCD_Write_4bits(data);
+void LCD_Send_data(LCD *LCD_Struct, uint8 data)
+{
+    LCD_Lock(LCD_Struct, LCD_Call_write);
+    if(LCD_Reserve(LCD_Struct, 1)){
+        LCD_Send(LCD_Struct, LCD_SEND_DATA, data);
+        LCD_Struct->address = LCD_NextAddress(LCD_Struct, LCD_Struct->address);
+    }
+    LCD_Unlock(LCD_Struct);
 }
@@ -16,13 +16,102 @@
 
 #include "stdint.h"
 #include "IfxPort.h"
+#include "Cpu/Std/IfxCpu.h"
+#include "Stm/Std/IfxStm.h"
+#include "Gtm/Tom/Pwm/IfxGtm_Tom_Pwm.h"
+#include "Dma/Dma/IfxDma_Dma.h"
+#include "_Lib/DataHandling/Ifx_Fifo.h"
 
 /*********************************************************************************************************************/
 /*-----------------------------------------------------Defines-------------------------------------------------------*/
 /*********************************************************************************************************************/
 
+/*
+ * @MODE_8_BITS
+ * @brief: Define it so @ref LCD_Init also takes DB0-DB3. The bus width is chosen per LCD at run time:
+ *         8 bits when DB0 is given, 4 bits when it is NULL.
+ */
 //#define MODE_8_BITS
 
+/*
+ * @HEAP
+ * @brief: Set to 0 to leave out @ref LCD_Init and the heap, LCDs are then created with @ref LCD_InitStatic.
+ */
+#ifndef LCD_USE_HEAP
+#define LCD_USE_HEAP    1
+#endif
+
+/*
+ * @STATS
+ * @brief: Set to 1 to count the bus transfers and the CPU cycles of every call in the stats field of @ref LCD.
+ *         When 0 neither the fields nor the code exist.
+ */
+#ifndef LCD_USE_STATS
+#define LCD_USE_STATS   0
+#endif
+#ifndef LCD_STATS_BINS
+#define LCD_STATS_BINS  12      //Latency histogram: bin 0 below 512 cycles, then one bin per power of 2.
+#endif
+
+/*
+ * @TRANSFER_FLAGS
+ * @brief: Flags of a command or data byte, given to the transport backends @ref LCD_TRANSPORT.
+ */
+#define LCD_SEND_DATA   0X01   //RS = 1, otherwise the byte is a command.
+#define LCD_SEND_LONG   0X02   //Clear display or return home, the execution time is longer.
+#define LCD_SEND_NIBBLE 0X04   //Only the upper nibble is written, for the initialization by instruction.
+
+/*
+ * @FIELD_FORMATS
+ * @brief: Formats of @ref LCD_PrintField, ORed with the flags.
+ */
+#define LCD_FIELD_INT           0X0000                          //Decimal integer.
+#define LCD_FIELD_FIXED(d)      (0X0001 | ((d) << 4))           //Fixed point with d decimals (0-9), 1234 is 12.34 with d = 2.
+#define LCD_FIELD_HEX           0X0002                          //Hexadecimal of the value as uint32, upper case.
+#define LCD_FIELD_ENG(e)        (0X0003 | ((((e) / 3) + 4) << 4))  //value * 10^e with 3 digits and a SI prefix, e multiple of 3 (-12 to 12).
+#define LCD_FIELD_ZEROPAD       0X0100                          //Pad with zeros after the sign instead of spaces.
+#define LCD_FIELD_PLUS          0X0200                          //Write '+' before positive values.
+
+/*
+ * @GEOMETRY
+ * @brief: Largest panel supported, the DDRAM of a HD44780 holds 80 characters.
+ */
+#define LCD_MAX_ROWS    4
+#define LCD_MAX_CELLS   80
+
+/*
+ * @GLYPHS
+ * @brief: Number of logical glyphs that can be registered, they share the 8 CGRAM slots of the LCD.
+ */
+#ifndef LCD_MAX_GLYPHS
+#define LCD_MAX_GLYPHS  32
+#endif
+#define LCD_CGRAM_SLOTS 8
+#define LCD_GLYPH_ROWS  8      //Rows of a 5x8 glyph bitmap, bits 4-0 of each row are the pixels.
+#define LCD_GLYPH_NONE  0XFF   //Empty CGRAM slot.
+
+/*
+ * @GAUGE_GLYPHS
+ * @brief: Glyph IDs taken by @ref LCD_PrintBar (5, bars of 1 to 5 pixel columns) and @ref LCD_PrintBigNumber
+ *         (3, upper, lower and both strokes). Together they fill the 8 CGRAM slots.
+ */
+#define LCD_GLYPH_BAR   (LCD_MAX_GLYPHS - 8)
+#define LCD_GLYPH_BIG   (LCD_MAX_GLYPHS - 3)
+
+/*
+ * @DMA
+ * @brief: Number of DMA transaction sets (32 bytes each) of @ref LCD_DMA, a byte takes up to 2 + 2 * (ports + 1).
+ */
+#ifndef LCD_DMA_LIST_LENGTH
+#define LCD_DMA_LIST_LENGTH 256
+#endif
+
+/*
+ * @ASYNC
+ * @brief: Number of commands/data bytes the asynchronous transmit queue can hold, @ref LCD_ASYNC.
+ */
+#define LCD_ASYNC_QUEUE_LENGTH  128
+
 /*
  * @LCD COMMANDS
  * @brief: The commands to set up the LCD
@@ -40,8 +129,8 @@
  * @ENTRY MODE SET
  * @brief: Entry modes to write in ENTRY MODE SET command.
  */
-#define LCD_ENTRY_RIGHT 0X00   //Cursor/blink moves to right and DDRAM address is increased by 1.
-#define LCD_ENTRY_LEFT  0X02   //Cursor/blink moves to left and DDRAM in decreased by 1.
+#define LCD_ENTRY_RIGHT 0X02   //Cursor/blink moves to right and DDRAM address is increased by 1 (I/D = 1).
+#define LCD_ENTRY_LEFT  0X00   //Cursor/blink moves to left and DDRAM in decreased by 1 (I/D = 0).
 /*NOTAS FIDEL: AGREGAR FUNCIONALIDAD DEL BIT S*/
 
 /*
@@ -61,6 +150,8 @@
  */
 #define LCD_SHIFT_CURSOR_LEFT   0X00   //Shifts the cursor position to the left, address counter is decreased by 1.
 #define LCD_SHIFT_CURSOR_RIGHT  0X01   //Shifts the cursor position to the right, address counter is increased by 1.
+#define LCD_SHIFT_DISPLAY_LEFT  0X08   //Shifts the entire display to the left, the address counter does not change.
+#define LCD_SHIFT_DISPLAY_RIGHT 0X0C   //Shifts the entire display to the right, the address counter does not change.
 
 /*
  * @FUNCTION SET
@@ -73,6 +164,36 @@
 #define LCD_FUNCTION_LENGTH_4   0X00   //4-Bit bus mode with MPU.
 #define LCD_FUNCTION_LENGTH_8   0X10   //8-Bit bus mode with MPU.
 
+/*
+ * @READ BUSY FLAG & ADDRESS
+ * @brief: Bits of the byte read with RS = 0, RW = 1.
+ */
+#define LCD_BUSYFLAG            0X80   //Internal operation is in progress, next instruction is not accepted.
+#define LCD_ADDRESSCOUNTER_MASK 0X7F   //Address counter used for both DDRAM and CGRAM addresses.
+#define LCD_ADDRESS_UNKNOWN     0XFF   //The driver does not know the address counter, the next write sets it.
+
+/*
+ * @TIMING
+ * @brief: HD44780 datasheet minimums, used as default timing of a panel @ref LCD_TIMING.
+ */
+#define LCD_TIMING_ADDRESS_SETUP_NS 40     //RS, RW setup time before E rises (tAS).
+#define LCD_TIMING_ENABLE_PULSE_NS  450    //Enable pulse width, high level (PWEH).
+#define LCD_TIMING_ENABLE_CYCLE_NS  1000   //Enable cycle time (tcycE).
+#define LCD_TIMING_EXEC_US          37     //Execution time of a command or data write.
+#define LCD_TIMING_CLEARHOME_US     1520   //Execution time of clear display and return home.
+#define LCD_TIMING_DATA_DELAY_NS    360    //Data valid after E rises when reading (tDDR).
+#define LCD_TIMING_POWERON_US       40000  //Wait after Vcc rises to 2.7 V, counted from the reset of the STM.
+#define LCD_TIMING_RESET1_US        4100   //Wait after the 1st function set of the initialization by instruction.
+#define LCD_TIMING_RESET2_US        100    //Wait after the 2nd function set of the initialization by instruction.
+
+/*
+ * @LCD_READY_HOOK
+ * @brief: Called by @ref LCD_BeginPoll when a LCD becomes ready, e.g. to log its readyTime.
+ */
+#ifndef LCD_READY_HOOK
+#define LCD_READY_HOOK(lcd)
+#endif
+
 /*********************************************************************************************************************/
 /*-------------------------------------------------Data Structures---------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -86,31 +207,346 @@ typedef struct _LCD_PIN{
         uint8 pinIndex;
 }LCD_PIN;
 
+/*
+ * @LCD_GEOMETRY_STRUCTURE
+ * @brief: Visible size of a panel and the DDRAM address of the first column of each row.
+ */
+typedef struct _LCD_GEOMETRY{
+        uint8 cols;
+        uint8 rows;
+        uint8 rowOffset[LCD_MAX_ROWS];
+}LCD_GEOMETRY;
+
+/*
+ * @LCD_GEOMETRIES
+ * @brief: Geometries of the usual panels, for @ref LCD_Config or @ref LCD_SetGeometry.
+ */
+extern const LCD_GEOMETRY LCD_Geometry_16x1;
+extern const LCD_GEOMETRY LCD_Geometry_16x2;
+extern const LCD_GEOMETRY LCD_Geometry_20x2;
+extern const LCD_GEOMETRY LCD_Geometry_20x4;
+extern const LCD_GEOMETRY LCD_Geometry_40x2;
+
+/*
+ * @LCD_GLYPH_CACHE_STRUCTURE
+ * @brief: Maps the registered glyphs onto the CGRAM slots, the least recently used slot is replaced.
+ */
+typedef struct _LCD_GLYPH_CACHE{
+        const uint8 *bitmap[LCD_MAX_GLYPHS];    //Registered bitmaps of LCD_GLYPH_ROWS bytes, not copied.
+        uint8 slotGlyph[LCD_CGRAM_SLOTS];       //Glyph held by each slot, LCD_GLYPH_NONE if empty.
+        uint32 slotUse[LCD_CGRAM_SLOTS];        //Value of useCount when the slot was last used.
+        uint32 useCount;
+        uint32 hits;                            //Glyph already in CGRAM, no upload.
+        uint32 misses;                          //Glyph uploaded to CGRAM.
+}LCD_GLYPH_CACHE;
+
+/*
+ * @LCD_CONFIG_STRUCTURE
+ * @brief: Pin table of a LCD, declare it const so it stays in flash, see @ref LCD_DEFINE.
+ */
+typedef struct _LCD_CONFIG{
+        LCD_PIN E;
+        LCD_PIN RS;
+        LCD_PIN RW;
+        LCD_PIN DB4;
+        LCD_PIN DB5;
+        LCD_PIN DB6;
+        LCD_PIN DB7;
+        const LCD_GEOMETRY *geometry;   //NULL for a 16x2 panel.
+        LCD_PIN DB0;                    //DB0-DB3 are only used in 8 bits mode, leave DB0.port NULL for 4 bits mode.
+        LCD_PIN DB1;
+        LCD_PIN DB2;
+        LCD_PIN DB3;
+}LCD_Config;
+
+/*
+ * @LCD_BUS_GROUP_STRUCTURE
+ * @brief: Data bus pins that share one port, they are written together with a single OMR access.
+ */
+typedef struct _LCD_BUS_GROUP{
+        Ifx_P *port;
+        uint32 omrHigh[16];     //OMR word that sets the DB4-DB7 pins of this port to each nibble value.
+        uint32 omrLow[16];      //Same for DB0-DB3 in 8 bits mode, the words of both nibbles are ORed.
+}LCD_BUS_GROUP;
+
+/*
+ * @LCD_TIMING_STRUCTURE
+ * @brief: Controller timing of a panel, see @TIMING for the datasheet values.
+ */
+typedef struct _LCD_TIMING{
+        uint32 addressSetup_ns;
+        uint32 enablePulse_ns;
+        uint32 enableCycle_ns;
+        uint32 exec_us;
+        uint32 clearHome_us;
+}LCD_TIMING;
+
+struct _LCD;
+
+/*
+ * @LCD_TRANSPORT_STRUCTURE
+ * @brief: Backend that carries the bytes to a LCD which is not wired to port pins, e.g. @ref LCD_Pcf8574Init.
+ *         The busy flag and the reads are not available through a transport.
+ */
+typedef struct _LCD_TRANSPORT{
+        void (*write)(struct _LCD *LCD_Struct, uint8 flags, uint8 value);  //Queue a byte, see @TRANSFER_FLAGS.
+        void (*flush)(struct _LCD *LCD_Struct);                            //Send the queued bytes, in order with the previous ones.
+        boolean (*isBusy)(struct _LCD *LCD_Struct);                        //TRUE while the flushed bytes are written, NULL if flush returns once they are.
+}LCD_TRANSPORT;
+
+/*
+ * @LCD_STROBE_STRUCTURE
+ * @brief: GTM TOM channel generating the enable pulse in one-shot mode, see @ref LCD_StrobeInit.
+ */
+typedef struct _LCD_STROBE{
+        IfxGtm_Tom_Pwm_Driver tom;
+        uint32 pulseTicks;          //GTM ticks of E high (CM1).
+        uint32 cycleTicks;          //GTM ticks of the whole enable cycle (CM0).
+        uint32 dataDelayTicks;      //GTM ticks after E rises before the data bus is read.
+}LCD_STROBE;
+
+/*
+ * @LCD_DMA_STRUCTURE
+ * @brief: Linked list of DMA transaction sets writing port OMR words, paced by a GTM TOM channel,
+ *         see @ref LCD_DmaInit. Every transfer of the list takes one period of the TOM channel.
+ */
+typedef struct _LCD_DMA{
+        IFX_ALIGN(IFX_ALIGN_256) Ifx_DMA_CH list[LCD_DMA_LIST_LENGTH];    //Transaction sets, 32 bytes aligned.
+        uint32 words[LCD_DMA_LIST_LENGTH];      //OMR words of the data bus, one per data transaction set.
+        uint32 eWords[2];                       //OMR words of E high and E low.
+        uint32 rsWords[2];                      //OMR words of RS low and RS high.
+        uint32 stopWord;                        //TGC ENDIS_STAT word that disables the TOM channel at the end.
+        uint32 enabledWord;                     //TGC ENDIS_STAT bit set while the TOM channel is enabled.
+        IfxDma_Dma module;
+        IfxDma_Dma_ChannelConfig config;        //Settings shared by every transaction set.
+        IfxDma_Dma_Channel channel;
+        IfxGtm_Tom_Pwm_Driver tick;             //TOM channel requesting one DMA transfer per period.
+        uint16 execTransfers;                   //Periods of the execution time of a command or data write.
+        uint16 clearHomeTransfers;              //Periods of the execution time of clear display and return home.
+        uint16 entries;                         //Transaction sets in the list.
+        uint16 wordCount;
+        boolean running;
+        uint32 runs;                            //Number of lists played.
+        uint32 maxEntries;                      //Longest list played.
+}LCD_DMA;
+
+/*
+ * @LCD_INIT_STEP
+ * @brief: Steps of the power-on sequence run by @ref LCD_BeginPoll.
+ */
+typedef enum{
+        LCD_InitStep_powerOn,       //Waiting for the LCD to power up.
+        LCD_InitStep_reset2,        //2nd function set of the initialization by instruction.
+        LCD_InitStep_reset3,        //3rd function set.
+        LCD_InitStep_busWidth,      //4 bits mode switch, skipped in 8 bits mode.
+        LCD_InitStep_functionSet,
+        LCD_InitStep_displayControl,
+        LCD_InitStep_entryMode,
+        LCD_InitStep_clear,
+        LCD_InitStep_finish,        //Waiting for the clear display to be executed.
+        LCD_InitStep_ready
+}LCD_InitStep;
+
+/*
+ * @LCD_Call
+ * @brief: Kinds of public calls, the latency histogram of @ref LCD_STATS is kept per kind.
+ */
+typedef enum{
+        LCD_Call_setup,             //LCD_Set*, LCD_StrobeInit.
+        LCD_Call_begin,             //LCD_BeginStart, LCD_BeginPoll.
+        LCD_Call_clear,             //LCD_ClearScreen, LCD_Home.
+        LCD_Call_write,             //LCD_SetCursor, LCD_Put*, LCD_WriteRun, LCD_Send_*.
+        LCD_Call_glyph,             //LCD_RegisterGlyph, LCD_UseGlyph.
+        LCD_Call_frame,             //LCD_Flush, LCD_ShowPage, LCD_Marquee*.
+        LCD_Call_read,              //LCD_Read*.
+        LCD_Call_count
+}LCD_Call;
+
+#if LCD_USE_STATS
+/*
+ * @LCD_STATS_STRUCTURE
+ * @brief: Bus and CPU time counters, the cycles are those of IfxCpu_getClockCounter of the calling CPU.
+ *         The performance counters must be started, e.g. IfxCpu_resetAndStartCounters(IfxCpu_CounterMode_normal).
+ */
+typedef struct _LCD_STATS{
+        uint32 commands;            //Command bytes written, nibbles of the initialization included.
+        uint32 dataBytes;           //Data bytes written.
+        uint32 strobes;             //Enable pulses.
+        uint32 transportErrors;     //Transfers the transport backend gave up, e.g. I2C NAK after the retries.
+        uint64 cycles;              //Cycles spent inside the public calls, spin lock wait included.
+        uint32 worstCycles;         //Longest single call.
+        LCD_Call worstCall;
+        uint32 calls[LCD_Call_count];
+        uint32 histogram[LCD_Call_count][LCD_STATS_BINS];
+
+        uint32 start;               //Clock counter when the current call started.
+        LCD_Call call;              //Kind of the current call.
+}LCD_STATS;
+#endif
+
+/*
+ * @LCD_ASYNC_STRUCTURE
+ * @brief: Transmit queue and counters of the asynchronous mode, see @ref LCD_AsyncInit.
+ */
+typedef struct _LCD_ASYNC{
+        Ifx_STM *stm;
+        IfxStm_Comparator comparator;
+        Ifx_Fifo *fifo;
+        volatile boolean busy;      //A transfer is in progress, the ISR fetches the next one.
+        IfxCpu_spinLock lock;       //Makes the check of busy and the kick atomic against the ISR, on any CPU.
+        boolean exchanging;         //The ISR flushed a transport, the next compare match checks that it is over.
+        uint8 exchangeFlags;        //Flags of the transfer being exchanged.
+
+        uint32 maxDepth;            //Highest number of transfers waiting in the queue.
+        uint32 overruns;            //Calls dropped as the queue had no room for all their transfers.
+        uint32 drainStart;          //STM time when the queue started to be emptied.
+        uint32 lastDrainTicks;      //STM ticks from the first write until the queue was empty, last time.
+        uint32 maxDrainTicks;       //STM ticks from the first write until the queue was empty, worst case.
+
+        //Each transfer is 2 bytes, plus room for the fifo object and its alignment.
+        uint64 fifoBuffer[(sizeof(Ifx_Fifo) + 2 * LCD_ASYNC_QUEUE_LENGTH + 8) / 8 + 1];
+}LCD_ASYNC;
+
+/*
+ * @LCD_PAGE_STRUCTURE
+ * @brief: Off-screen screen, written at any time without bus traffic and shown by @ref LCD_ShowPage.
+ */
+typedef struct _LCD_PAGE{
+        uint8 cells[LCD_MAX_CELLS];     //Row after row, as the frame of the LCD.
+}LCD_PAGE;
+
+/*
+ * @LCD_TERMINAL_STRUCTURE
+ * @brief: Cursor of the terminal model used by @ref LCD_stdIfDPipeInit, the text goes to the frame of the LCD.
+ */
+typedef struct _LCD_TERMINAL{
+        uint8 row;
+        uint8 col;                  //Equal to the columns when the next printable char wraps to the next row.
+        uint32 sendCount;           //Chars accepted by the write side.
+        uint32 flushes;             //Frames sent to the LCD.
+        sint64 txTimestamp;         //STM time of the last frame sent.
+}LCD_TERMINAL;
+
+/*
+ * @LCD_MARQUEE_STRUCTURE
+ * @brief: Text scrolled by the display shift of the LCD. Each DDRAM line is a ring of 40 columns (80 on 1 line
+ *         panels) and the columns out of the window are refilled with the text that comes next.
+ */
+typedef struct _LCD_MARQUEE{
+        const uint8 *text[2];       //Text of each row, repeated when it is shorter than the ring, NULL for blanks.
+        uint32 length[2];
+        uint8 lineLength;           //DDRAM columns of a line.
+        uint32 position;            //Text position at the left of the window, i.e. steps done.
+        uint8 stale;                //Columns scrolled out of the window and not refilled yet.
+        uint32 steps;               //Shift commands sent.
+        uint32 refills;             //Bytes sent to refill the hidden columns.
+}LCD_MARQUEE;
+
 /*
  *@LCD_STRUCTURE
  *@brief: Define all pins of LCD.
+ *        Each LCD is independent, and every function that drives the bus takes the LCD lock, so several LCDs can
+ *        be used from different CPUs at the same time and one LCD can be shared by several CPUs. A shared LCD
+ *        must be placed in memory that every CPU sees uncached. LCD_Print* only write the frame and are not locked.
  */
 typedef struct _LCD{
-        LCD_PIN *E;
-        LCD_PIN *RS;
-        LCD_PIN *RW;
-
-#ifdef  MODE_8_BITS
-        LCD_PIN *DB0;
-        LCD_PIN *DB1;
-        LCD_PIN *DB2;
-        LCD_PIN *DB3;
-#endif
-        LCD_PIN *DB4;
-        LCD_PIN *DB5;
-        LCD_PIN *DB6;
-        LCD_PIN *DB7;
+        const LCD_PIN *E;
+        const LCD_PIN *RS;
+        const LCD_PIN *RW;
 
+        const LCD_PIN *DB0;         //DB0-DB3 are NULL in 4 bits mode.
+        const LCD_PIN *DB1;
+        const LCD_PIN *DB2;
+        const LCD_PIN *DB3;
+        const LCD_PIN *DB4;
+        const LCD_PIN *DB5;
+        const LCD_PIN *DB6;
+        const LCD_PIN *DB7;
+
+        const LCD_GEOMETRY *geometry;
         uint8 col;
         uint8 row;
+        uint8 address;              //Address counter of the LCD as computed by the driver, LCD_ADDRESS_UNKNOWN if not known.
+
+        IfxCpu_spinLock lock;       //Taken by every public function that drives the LCD.
+
+        boolean mode8Bits;          //A byte is written with one enable strobe instead of two.
+        LCD_BUS_GROUP bus[8];       //Data bus pins grouped by port, computed by @ref LCD_Init.
+        uint8 busGroups;
+        uint8 rsState;              //Last level written on RS, so it is only written when it changes.
+
+        LCD_TIMING timing;
+        uint32 addressSetupTicks;   //STM ticks computed from timing by @ref LCD_SetTiming.
+        uint32 enableHighTicks;
+        uint32 enableLowTicks;
+        uint32 execTicks;
+        uint32 clearHomeTicks;
+
+        boolean useBusyFlag;        //Poll the busy flag instead of waiting the execution times.
+        uint32 busyTimeoutTicks;    //Maximum time polling the busy flag before falling back to delays.
+        uint32 busyTimeouts;        //Number of times the busy flag polling timed out.
+
+        LCD_ASYNC *async;           //Transmit queue, NULL when the LCD is written synchronously.
+        LCD_STROBE *strobe;         //Hardware enable pulse, NULL when E is driven by software.
+        LCD_DMA *dma;               //DMA engine, NULL when the CPU drives the bus.
+        const LCD_TRANSPORT *transport; //Backend of a LCD without port pins, NULL for the parallel bus.
+        void *transportData;            //State of the backend.
+        LCD_MARQUEE *marquee;           //Running marquee, NULL when the display is not shifted.
+        LCD_TERMINAL terminal;          //Write side of the standard interface pipe.
+
+#if LCD_USE_STATS
+        LCD_STATS stats;
+#endif
+
+        LCD_PAGE *page;             //Page shown instead of the frame, NULL for the frame.
+        uint32 pageFlips;           //Calls of @ref LCD_ShowPage.
+        uint32 pageBytesSent;       //Bytes sent by the page flips.
+        uint32 pageBytesSaved;      //Bytes the page flips saved against redrawing the whole screen.
+
+        LCD_InitStep initStep;      //Next step of @ref LCD_BeginPoll.
+        uint64 initDeadline;        //STM time the current step waits for, the busy flag timeout in busy flag mode.
+        uint64 initStartTime;       //IfxStm_get when @ref LCD_BeginStart was called.
+        uint64 readyTime;           //IfxStm_get when the LCD became ready, i.e. time since reset, 0 before.
+
+        LCD_GLYPH_CACHE glyphs;
+
+        uint8 frame[LCD_MAX_CELLS];     //Screen to be shown row after row, written by LCD_Print* without bus traffic.
+        uint8 shadow[LCD_MAX_CELLS];    //Copy of the visible DDRAM, @ref LCD_Flush sends only the differences.
 }LCD;
 
 
+/*
+ * @LCD_DSPR_SECTION
+ * @brief: Place a variable in the data scratch-pad RAM of a CPU (0, 1 or 2).
+ */
+#if defined(__HIGHTEC__)
+#define LCD_DSPR_SECTION(core)  __attribute__ ((section(".bss_cpu" #core)))
+#else
+#define LCD_DSPR_SECTION(core)
+#endif
+
+/*
+ * @LCD_DEFINE
+ * @brief: Define a LCD named name in the DSPR of CPU core and its pin table name##_config in flash.
+ *         Each pin is given as port, pin index, e.g. with the macros of LCD_PINSET.h:
+ *         LCD_DEFINE(Lcd, 0, PIN_E, PIN_RS, PIN_RW, PIN_DB4, PIN_DB5, PIN_DB6, PIN_DB7);
+ *         LCD_InitStatic(&Lcd, &Lcd_config);
+ *         The panel is 16x2, call @ref LCD_SetGeometry before @ref LCD_Begin for another size.
+ */
+#define LCD_DEFINE(name, core, e, rs, rw, db4, db5, db6, db7) \
+        const LCD_Config name##_config = {{e}, {rs}, {rw}, {db4}, {db5}, {db6}, {db7}, NULL, \
+                {NULL}, {NULL}, {NULL}, {NULL}}; \
+        LCD name LCD_DSPR_SECTION(core)
+
+/*
+ * @LCD_DEFINE_8BITS
+ * @brief: Same as @ref LCD_DEFINE for a LCD with the 8 data lines connected.
+ */
+#define LCD_DEFINE_8BITS(name, core, e, rs, rw, db0, db1, db2, db3, db4, db5, db6, db7) \
+        const LCD_Config name##_config = {{e}, {rs}, {rw}, {db4}, {db5}, {db6}, {db7}, NULL, \
+                {db0}, {db1}, {db2}, {db3}}; \
+        LCD name LCD_DSPR_SECTION(core)
+
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -121,7 +557,7 @@ typedef struct _LCD{
  *@param: Pointer to Enable pin structure, @ref LCD_PIN.
  *@param: Pointer to RS pin structure, @ref LCD_PIN.
  *@param: Pointer to RW pin structure, @ref LCD_PIN.
- *@param: Pointer to DB0 pin structure, @ref LCD_PIN.
+ *@param: Pointer to DB0 pin structure, @ref LCD_PIN. Only with MODE_8_BITS, NULL for 4 bits mode.
  *@param: Pointer to DB1 pin structure, @ref LCD_PIN.
  *@param: Pointer to DB2 pin structure, @ref LCD_PIN.
  *@param: Pointer to DB3 pin structure, @ref LCD_PIN.
@@ -130,19 +566,188 @@ typedef struct _LCD{
  *@param: Pointer to DB6 pin structure, @ref LCD_PIN.
  *@param: Pointer to DB7 pin structure, @ref LCD_PIN.
  */
+#if LCD_USE_HEAP
 LCD* LCD_Init(LCD_PIN *E, LCD_PIN *RS, LCD_PIN *RW,
 #ifdef MODE_8_BITS
-        LCD_PIN *DBO, LCD_PIN *DB1, LCD_PIN *DB2, LCD_PIN *DB3,
+        LCD_PIN *DB0, LCD_PIN *DB1, LCD_PIN *DB2, LCD_PIN *DB3,
 #endif
         LCD_PIN *DB4, LCD_PIN *DB5, LCD_PIN *DB6, LCD_PIN *DB7);
+#endif
+
+/*
+ *@LCD_InitStatic
+ *@brief: Initialize LCD parameters in a storage given by the caller, no heap is used.
+ *@param: Pointer to the storage of the structure @ref LCD, see @ref LCD_DEFINE.
+ *@param: Pointer to the pin table @ref LCD_Config, it must live as long as the LCD.
+ *@return: Pointer to the initialized LCD, i.e. storage.
+ */
+LCD* LCD_InitStatic(LCD *storage, const LCD_Config *cfg);
+
+/*
+ *@LCD_InitTransport
+ *@brief: Initialize a LCD driven through a transport backend instead of port pins.
+ *        The backends call it, e.g. @ref LCD_Pcf8574Init.
+ *@param: Pointer to the storage of the structure @ref LCD.
+ *@param: Pointer to the functions of the backend @ref LCD_TRANSPORT.
+ *@param: State of the backend, stored in transportData.
+ *@return: Pointer to the initialized LCD, i.e. storage.
+ */
+LCD* LCD_InitTransport(LCD *storage, const LCD_TRANSPORT *transport, void *data);
+
+/*
+ *@LCD_Lock
+ *@brief: Take the spin lock of the LCD. Every LCD_* call takes it, the transport backends take it
+ *        too before changing their own state outside of a call, e.g. @ref LCD_Pcf8574SetBacklight.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Kind of call, for the statistics.
+ */
+void LCD_Lock(LCD *LCD_Struct, LCD_Call call);
+
+/*
+ *@LCD_Unlock
+ *@brief: Release the spin lock taken by @ref LCD_Lock.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_Unlock(LCD *LCD_Struct);
+
+/*
+ *@LCD_SetGeometry
+ *@brief: Set the size of the panel, before @ref LCD_Begin. @ref LCD_Init selects 16x2.
+ *        The frames are cleared.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the geometry @ref LCD_GEOMETRY, e.g. &LCD_Geometry_20x4.
+ */
+void LCD_SetGeometry(LCD *LCD_Struct, const LCD_GEOMETRY *geometry);
+
+/*
+ *@LCD_SetTiming
+ *@brief: Set the controller timing of the panel, @ref LCD_Init sets the datasheet minimums.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to timing structure @ref LCD_TIMING.
+ */
+void LCD_SetTiming(LCD *LCD_Struct, const LCD_TIMING *timing);
+
+/*
+ *@LCD_SetBusyFlagMode
+ *@brief: Enable or disable the busy flag polling, RW and DB4-DB7 must be wired to be read back.
+ *        If the busy flag does not clear within the timeout the driver falls back to the fixed delays.
+ *        Call it after @ref LCD_Begin, the busy flag cannot be read before the function set.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: TRUE to poll the busy flag, FALSE to wait the execution times.
+ */
+void LCD_SetBusyFlagMode(LCD *LCD_Struct, boolean enable);
+
+/*
+ *@LCD_StrobeInit
+ *@brief: Generate the enable pulse with a GTM TOM channel in one-shot mode instead of software waits.
+ *        The E pin is switched to the TOM output, so its pulse width does not depend on interrupts.
+ *        The pulse and cycle times are those of @ref LCD_TIMING.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the storage of the strobe, it must live as long as the LCD.
+ *@param: TOUT map of the E pin, e.g. &IfxGtm_TOM1_6_TOUT74_P15_3_OUT for P15.3.
+ *@return: TRUE if the TOM channel has been initialized.
+ */
+boolean LCD_StrobeInit(LCD *LCD_Struct, LCD_STROBE *strobe, IfxGtm_Tom_ToutMap *pin);
+
+/*
+ *@LCD_DmaInit
+ *@brief: Let the DMA drive the bus. Each public function compiles its transfers into a list of port OMR
+ *        writes (data setup, E high, E low, execution time) which is played by a DMA linked list paced by a
+ *        GTM TOM channel, so the function returns as soon as the list is started.
+ *        Call it after @ref LCD_Begin, not together with @ref LCD_AsyncInit or @ref LCD_StrobeInit.
+ *        The busy flag is not used, the execution times of @ref LCD_TIMING are waited.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the storage of the DMA engine, it must live as long as the LCD. If it is in a DSPR,
+ *        it must be the DSPR of the CPU calling this function.
+ *@param: DMA channel.
+ *@param: TOM of the pacing channel.
+ *@param: TOM channel used to pace the DMA, it has no output pin.
+ *@return: TRUE if the DMA engine is used.
+ */
+boolean LCD_DmaInit(LCD *LCD_Struct, LCD_DMA *dma, IfxDma_ChannelId channel, IfxGtm_Tom tom, IfxGtm_Tom_Ch tomChannel);
+
+/*
+ *@LCD_DmaIsBusy
+ *@brief: Tell if the DMA is still playing a list.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@return: TRUE while the list is played.
+ */
+boolean LCD_DmaIsBusy(LCD *LCD_Struct);
+
+/*
+ *@LCD_DmaWait
+ *@brief: Wait until the DMA has played the whole list, including the execution time of the last transfer.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_DmaWait(LCD *LCD_Struct);
+
+/*
+ *@LCD_AsyncInit
+ *@brief: Switch the LCD to asynchronous mode, commands and data are queued and sent by a STM compare interrupt.
+ *        The application must route the interrupt to @ref LCD_AsyncIsr:
+ *        IFX_INTERRUPT(lcdIsr, 0, priority) { LCD_AsyncIsr(lcd); }
+ *        The busy flag is not polled in this mode. A call whose transfers do not all fit in the queue is dropped
+ *        before it changes anything and counted in the overruns, it never waits.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the queue storage @ref LCD_ASYNC, it must live as long as the LCD.
+ *@param: STM module whose comparator paces the transfers.
+ *@param: Comparator to use, its interrupt output is the one with the same index.
+ *@param: Interrupt priority.
+ *@param: Type of service (CPU) of the interrupt.
+ *@return: TRUE if the comparator has been configured.
+ */
+boolean LCD_AsyncInit(LCD *LCD_Struct, LCD_ASYNC *async, Ifx_STM *stm, IfxStm_Comparator comparator,
+        Ifx_Priority priority, IfxSrc_Tos typeOfService);
+
+/*
+ *@LCD_AsyncIsr
+ *@brief: Send the next queued transfer and program the comparator for its execution time.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_AsyncIsr(LCD *LCD_Struct);
+
+/*
+ *@LCD_AsyncWait
+ *@brief: Wait until every queued transfer has been executed by the LCD.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_AsyncWait(LCD *LCD_Struct);
 
 /*
  *@LCD_Begin
- *@brief: Set initial default parameters for the LCD.
+ *@brief: Set initial default parameters for the LCD, blocking until it is ready.
+ *        Same as @ref LCD_BeginStart followed by @ref LCD_BeginPoll until it returns TRUE.
  *@param: LCD_struct pointer to structure @ref LCD.
  */
 void LCD_Begin(LCD *LCD_Struct);
 
+/*
+ *@LCD_BeginStart
+ *@brief: Start the power-on sequence without waiting, it is run by @ref LCD_BeginPoll.
+ *        The LCD must not be written until @ref LCD_BeginPoll returns TRUE.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_BeginStart(LCD *LCD_Struct);
+
+/*
+ *@LCD_BeginPoll
+ *@brief: Run the next step of the power-on sequence if its wait time is over, it never waits.
+ *        The datasheet minimums are used: 40 ms after reset, 4.1 ms, 100 us, then the busy flag or
+ *        the execution times of @ref LCD_TIMING. Call it periodically from the startup code.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@return: TRUE when the LCD is ready.
+ */
+boolean LCD_BeginPoll(LCD *LCD_Struct);
+
+/*
+ *@LCD_GetInitTime
+ *@brief: Time spent initializing the LCD, from @ref LCD_BeginStart until it was ready.
+ *        The readyTime field of @ref LCD is the time since reset.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@return: STM ticks, 0 if the LCD is not ready.
+ */
+uint64 LCD_GetInitTime(LCD *LCD_Struct);
+
 /*
  * @LCD_ClearScreen
  * @brief: Clear displays data and put set cursor position 0.
@@ -160,8 +765,8 @@ void LCD_Home(LCD *LCD_Struct);
 /*
  * @LCD_SetCursor
  * @brief: Move the cursor to a specific position.
- *         If @col excedds 0x4F, i.e., the last column of 2nd line, then
- *         it is reset to 0x00, i.e., the 1st column of the 1st line.
+ *         Row and column wrap around the size of the panel.
+ *         No command is sent if the address counter is already there.
  * @param: LCD_struct pointer to structure @ref LCD.
  * @param: Row position.
  * @param: Column position.
@@ -170,7 +775,8 @@ void LCD_SetCursor(LCD *LCD_Struct, uint8 row, uint8 col);
 
 /*
  * @LCD_PutChar
- * @brief: Put a char on the cursor.
+ * @brief: Put a char on the cursor. The cursor moves to the next row after the last column.
+ *         The address is only sent when the address counter of the LCD does not already follow.
  * @param: LCD_struct pointer to structure @ref LCD.
  * @param: Character to be put on the cursor.
  */
@@ -184,19 +790,247 @@ void LCD_PutChar(LCD *LCD_Struct, uint8 c);
  */
 void LCD_PutStr(LCD *LCD_Struct, uint8 *s);
 
+/*
+ * @LCD_WriteRun
+ * @brief: Write len chars from a position. The address is sent once and the chars are streamed with the
+ *         auto-increment of the LCD, it is only sent again where the next row does not follow in DDRAM.
+ *         The run wraps to the next row after the last column, the frame is kept in step.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row position.
+ * @param: Column position.
+ * @param: Chars to be written.
+ * @param: Number of chars.
+ */
+void LCD_WriteRun(LCD *LCD_Struct, uint8 row, uint8 col, const uint8 *buf, uint32 len);
+
+/*
+ * @LCD_RegisterGlyph
+ * @brief: Register the bitmap of a logical glyph. A glyph already in CGRAM is uploaded again on its next use.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Glyph ID, 0 to LCD_MAX_GLYPHS - 1.
+ * @param: Bitmap of LCD_GLYPH_ROWS bytes, it must stay valid (e.g. const in flash).
+ */
+void LCD_RegisterGlyph(LCD *LCD_Struct, uint8 id, const uint8 *bitmap);
+
+/*
+ * @LCD_UseGlyph
+ * @brief: Make a glyph resident in CGRAM and return its char code. If it is not resident the least
+ *         recently used slot is replaced, so chars of the replaced glyph still on screen change too.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Glyph ID.
+ * @return: Char code 0X08-0X0F to be written to DDRAM, 0X20 (space) if the glyph is not registered.
+ */
+uint8 LCD_UseGlyph(LCD *LCD_Struct, uint8 id);
+
+/*
+ * @LCD_PutGlyph
+ * @brief: Put a glyph on the cursor, see @ref LCD_UseGlyph.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Glyph ID.
+ */
+void LCD_PutGlyph(LCD *LCD_Struct, uint8 id);
+
+/*
+ * @LCD_PrintGlyph
+ * @brief: Put a glyph in the frame, it is uploaded to CGRAM now and shown on the next @ref LCD_Flush.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row position.
+ * @param: Column position.
+ * @param: Glyph ID.
+ */
+void LCD_PrintGlyph(LCD *LCD_Struct, uint8 row, uint8 col, uint8 id);
+
+/*
+ * @LCD_PrintBar
+ * @brief: Draw a horizontal bar in the frame with 5 steps per cell. The glyphs are only uploaded when they are
+ *         not in CGRAM, and @ref LCD_Flush only sends the cells whose level changed.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row position.
+ * @param: Column of the 1st cell.
+ * @param: Width of the bar in cells.
+ * @param: Value, 0 to max.
+ * @param: Value of a full bar.
+ */
+void LCD_PrintBar(LCD *LCD_Struct, uint8 row, uint8 col, uint8 width, uint32 value, uint32 max);
+
+/*
+ * @LCD_PrintBigNumber
+ * @brief: Draw a number in the frame with digits of 3x2 cells and a blank column between them, right aligned.
+ *         A number with more digits than the field shows its lower digits.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Upper row of the digits.
+ * @param: Column of the field.
+ * @param: Digits of the field, it takes 4 columns each.
+ * @param: Value.
+ */
+void LCD_PrintBigNumber(LCD *LCD_Struct, uint8 row, uint8 col, uint8 digits, uint32 value);
+
+/*
+ * @LCD_PrintChar
+ * @brief: Put a char in the frame, it is shown on the next @ref LCD_Flush.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row position.
+ * @param: Column position.
+ * @param: Character to be put in the frame.
+ */
+void LCD_PrintChar(LCD *LCD_Struct, uint8 row, uint8 col, uint8 c);
+
+/*
+ * @LCD_Print
+ * @brief: Put a string in the frame from a position, clipped at the end of the row.
+ *         It is shown on the next @ref LCD_Flush.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row position.
+ * @param: Column position.
+ * @param: String to be put in the frame.
+ */
+void LCD_Print(LCD *LCD_Struct, uint8 row, uint8 col, const uint8 *s);
+
+/*
+ * @LCD_PrintField
+ * @brief: Write a number right aligned in a field of the frame, nothing is sent until @ref LCD_Flush.
+ *         No sprintf nor heap is used. A number wider than the field fills it with '#'.
+ *         In the engineering format the prefix is one of p n u m k M G T, or a space.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @param: Row.
+ * @param: Column of the 1st char of the field.
+ * @param: Width of the field, up to 16 chars.
+ * @param: Value.
+ * @param: Format, see @FIELD_FORMATS.
+ */
+void LCD_PrintField(LCD *LCD_Struct, uint8 row, uint8 col, uint8 width, sint32 value, uint16 format);
+
+/*
+ * @LCD_PrintClear
+ * @brief: Fill the frame with spaces, unlike @ref LCD_ClearScreen nothing is sent until @ref LCD_Flush.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_PrintClear(LCD *LCD_Struct);
+
+/*
+ * @LCD_Flush
+ * @brief: Send to the LCD only the cells of the frame, or of the page shown, that differ from the display.
+ *         A DDRAM address is only set at the start of each run of changed cells.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_Flush(LCD *LCD_Struct);
+
+/*
+ *@LCD_PageClear
+ *@brief: Fill a page with spaces.
+ *@param: Pointer to the page.
+ */
+void LCD_PageClear(LCD_PAGE *page);
+
+/*
+ *@LCD_PagePrintChar
+ *@brief: Write a char in a page, nothing is sent. Positions out of the panel are ignored.
+ *@param: LCD_struct pointer to structure @ref LCD, which gives the geometry.
+ *@param: Pointer to the page.
+ *@param: Row.
+ *@param: Column.
+ *@param: Char.
+ */
+void LCD_PagePrintChar(LCD *LCD_Struct, LCD_PAGE *page, uint8 row, uint8 col, uint8 c);
+
+/*
+ *@LCD_PagePrint
+ *@brief: Write a zero terminated string in a page, it is cut at the last column. Nothing is sent.
+ *@param: LCD_struct pointer to structure @ref LCD, which gives the geometry.
+ *@param: Pointer to the page.
+ *@param: Row.
+ *@param: Column.
+ *@param: Pointer to the string.
+ */
+void LCD_PagePrint(LCD *LCD_Struct, LCD_PAGE *page, uint8 row, uint8 col, const uint8 *s);
+
+/*
+ *@LCD_ShowPage
+ *@brief: Show a page, only the cells that differ from the display are sent. While it is shown,
+ *        @ref LCD_Flush sends the changes of the page; NULL shows the frame again.
+ *        The pageFlips, pageBytesSent and pageBytesSaved counters of @ref LCD measure the flips.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the page, or NULL.
+ */
+void LCD_ShowPage(LCD *LCD_Struct, LCD_PAGE *page);
+
+/*
+ *@LCD_MarqueeStart
+ *@brief: Scroll a text on each row with the display shift of the LCD: the DDRAM lines are preloaded once and
+ *        each step is a single shift command. Only panels whose rows are whole DDRAM lines and have hidden
+ *        columns are supported (16x1, 16x2 and 20x2). While it runs @ref LCD_Flush keeps the frame for later.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pointer to the storage of the marquee, it must live until @ref LCD_MarqueeStop.
+ *@param: Zero terminated text of the 1st row, NULL for blanks.
+ *@param: Zero terminated text of the 2nd row, NULL for blanks.
+ *@return: FALSE if the geometry can not be scrolled.
+ */
+boolean LCD_MarqueeStart(LCD *LCD_Struct, LCD_MARQUEE *marquee, const uint8 *text0, const uint8 *text1);
+
+/*
+ *@LCD_MarqueeStep
+ *@brief: Scroll the marquee one column to the left. The hidden columns are refilled first if the next
+ *        step would show a stale one.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_MarqueeStep(LCD *LCD_Struct);
+
+/*
+ *@LCD_MarqueeRefill
+ *@brief: Refill the hidden columns scrolled out so far, as one run per row. Call it when the bus is idle
+ *        so @ref LCD_MarqueeStep stays a single command.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_MarqueeRefill(LCD *LCD_Struct);
+
+/*
+ *@LCD_MarqueeStop
+ *@brief: Return the display to its original position and show the frame of the LCD_Print* functions.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_MarqueeStop(LCD *LCD_Struct);
+
+#if LCD_USE_STATS
+/*
+ *@LCD_StatsReset
+ *@brief: Clear the counters of @ref LCD_STATS.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ */
+void LCD_StatsReset(LCD *LCD_Struct);
+#endif
+
+/*
+ * @LCD_ReadAddressCounter
+ * @brief: Read the address counter once the controller is ready.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @return: DDRAM or CGRAM address, depending on the last address set.
+ */
+uint8 LCD_ReadAddressCounter(LCD *LCD_Struct);
+
+/*
+ * @LCD_ReadData
+ * @brief: With RS = 1, RW = 1 a data byte is read from DDRAM or CGRAM at the address counter.
+ *         The address counter is increased or decreased according to the entry mode.
+ * @param: LCD_struct pointer to structure @ref LCD.
+ * @return: Byte data read.
+ */
+uint8 LCD_ReadData(LCD *LCD_Struct);
+
 /*
  * @LCD_Send_command
  * @brief: With RS = 0, RW = 0 a command byte is sent.
+ * @param: LCD_struct pointer to structure @ref LCD.
  * @param: Command to be sent.
  */
-void LCD_Send_command(uint8 cmd);
+void LCD_Send_command(LCD *LCD_Struct, uint8 cmd);
 
 /*
  * @LCD_Send_data
  * @brief: With RS = 1, RW = 0 a data byte is sent.
+ * @param: LCD_struct pointer to structure @ref LCD.
  * @param: Byte data to be sent.
  */
-void LCD_Send_data(uint8 data);
+void LCD_Send_data(LCD *LCD_Struct, uint8 data);
 
 
 #endif /* LCD_LCD_H_ */
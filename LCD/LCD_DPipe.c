@@ -0,0 +1,279 @@
+/**********************************************************************************************************************
+ * \file    LCD_DPipe.c
+ * \brief   Standard interface data pipe on the LCD, so Ifx_Console and Ifx_Shell can print on it.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "LCD_DPipe.h"
+#include <Stm/Std/IfxStm.h>
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Private Functions-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_DPipe_NewLine.
+ * @brief: Move the terminal cursor to the start of the next row, the frame scrolls up past the last row.
+ */
+static void LCD_DPipe_NewLine(LCD *LCD_Struct)
+{
+    LCD_TERMINAL *terminal = &LCD_Struct->terminal;
+    uint8 cols = LCD_Struct->geometry->cols;
+    uint8 rows = LCD_Struct->geometry->rows;
+
+    terminal->col = 0;
+    if(terminal->row + 1 < rows){
+        ++terminal->row;
+        return;
+    }
+    memmove(LCD_Struct->frame, LCD_Struct->frame + cols, (rows - 1) * cols);
+    memset(LCD_Struct->frame + (rows - 1) * cols, ' ', cols);
+}
+
+/*
+ * @LCD_DPipe_Idle.
+ * @brief: TRUE once the asynchronous queue or the DMA list of the LCD is empty.
+ */
+static boolean LCD_DPipe_Idle(LCD *LCD_Struct)
+{
+    if((LCD_Struct->async != NULL) && LCD_Struct->async->busy)
+        return FALSE;
+    if((LCD_Struct->dma != NULL) && LCD_DmaIsBusy(LCD_Struct))
+        return FALSE;
+    return TRUE;
+}
+
+/*
+ * @LCD_DPipe_Lay.
+ * @brief: Lay chars on the frame at the terminal cursor, nothing is sent.
+ */
+static void LCD_DPipe_Lay(LCD *LCD_Struct, const uint8 *c, Ifx_SizeT count)
+{
+    LCD_TERMINAL *terminal = &LCD_Struct->terminal;
+    uint8 cols = LCD_Struct->geometry->cols;
+
+    for(Ifx_SizeT i = 0; i < count; ++i){
+        switch(c[i]){
+        case '\r':
+            terminal->col = 0;
+            break;
+        case '\n':
+            LCD_DPipe_NewLine(LCD_Struct);
+            break;
+        case '\b':
+            if(terminal->col > 0)
+                terminal->col = ((terminal->col < cols) ? terminal->col : cols) - 1;
+            break;
+        default:
+            //The wrap is left pending, so a full row followed by ENDL does not leave an empty row.
+            if(terminal->col >= cols)
+                LCD_DPipe_NewLine(LCD_Struct);
+            LCD_Struct->frame[terminal->row * cols + terminal->col] = c[i];
+            ++terminal->col;
+            break;
+        }
+    }
+}
+
+/*
+ * @LCD_DPipe_getWriteCount.
+ * @brief: Chars a write can show: a screen, or less when the asynchronous queue could not take its cells.
+ *         Each cell costs 2 transfers (address and data) in the worst case.
+ */
+static sint32 LCD_DPipe_getWriteCount(LCD *LCD_Struct)
+{
+    sint32 count = LCD_Struct->geometry->rows * LCD_Struct->geometry->cols;
+
+    if(LCD_Struct->async != NULL){
+        sint32 room = Ifx_Fifo_writeCount(LCD_Struct->async->fifo) / (2 * LCD_Struct->async->fifo->elementSize);
+
+        if(room < count)
+            count = room;
+    }
+    return count;
+}
+
+static boolean LCD_DPipe_canWriteCount(LCD *LCD_Struct, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    sint64 deadline = IfxStm_getDeadLine(timeout);
+
+    while(LCD_DPipe_getWriteCount(LCD_Struct) < count){
+        if(IfxStm_isDeadLine(deadline))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/*
+ * @LCD_DPipe_write.
+ * @brief: Lay the chars on the frame and send the changed cells, a flush per @ref LCD_DPipe_getWriteCount chars.
+ *         Each flush waits for room up to the timeout, as IfxAsclin_Asc_write does for each fifo write. When it
+ *         expires, the chars the queue can show are taken and count is set to the chars accepted.
+ *         Text scrolled out before a flush is never sent.
+ * @return: FALSE if the timeout expired before all the chars were accepted.
+ */
+static boolean LCD_DPipe_write(LCD *LCD_Struct, void *data, Ifx_SizeT *count, Ifx_TickTime timeout)
+{
+    LCD_TERMINAL *terminal = &LCD_Struct->terminal;
+    const uint8 *c = (const uint8 *)data;
+    Ifx_SizeT screen = LCD_Struct->geometry->rows * LCD_Struct->geometry->cols;
+    Ifx_SizeT accepted = 0;
+    boolean result = TRUE;
+
+    while(result && (accepted < *count)){
+        Ifx_SizeT chunk = ((*count - accepted) < screen) ? (*count - accepted) : screen;
+
+        if(!LCD_DPipe_canWriteCount(LCD_Struct, chunk, timeout)){
+            sint32 room = LCD_DPipe_getWriteCount(LCD_Struct);
+
+            chunk = (room < chunk) ? (Ifx_SizeT)room : chunk;
+            result = FALSE;
+        }
+        if(chunk == 0)
+            break;
+
+        LCD_DPipe_Lay(LCD_Struct, &c[accepted], chunk);
+        accepted += chunk;
+        LCD_Flush(LCD_Struct);
+        ++terminal->flushes;
+        terminal->txTimestamp = (sint64)IfxStm_get(&MODULE_STM0);
+    }
+    terminal->sendCount += accepted;
+    *count = accepted;
+
+    return result;
+}
+
+/*
+ * @LCD_DPipe_flushTx.
+ * @brief: Send what differs and wait until the LCD shows it: the asynchronous queue or the DMA list is empty and
+ *         the exchange of the transport is over.
+ */
+static boolean LCD_DPipe_flushTx(LCD *LCD_Struct, Ifx_TickTime timeout)
+{
+    sint64 deadline = IfxStm_getDeadLine(timeout);
+
+    LCD_Flush(LCD_Struct);
+    while(!LCD_DPipe_Idle(LCD_Struct)){
+        if(IfxStm_isDeadLine(deadline))
+            return FALSE;
+    }
+    //A transport such as LCD_HC595 returns while its exchange goes on, it only takes the frames of one flush.
+    if((LCD_Struct->transport != NULL) && (LCD_Struct->transport->isBusy != NULL)){
+        while(LCD_Struct->transport->isBusy(LCD_Struct)){
+            if(IfxStm_isDeadLine(deadline))
+                return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static IfxStdIf_DPipe_WriteEvent LCD_DPipe_getWriteEvent(LCD *LCD_Struct)
+{
+    (void)LCD_Struct;
+    return NULL_PTR;
+}
+
+static uint32 LCD_DPipe_getSendCount(LCD *LCD_Struct)
+{
+    return LCD_Struct->terminal.sendCount;
+}
+
+static Ifx_TickTime LCD_DPipe_getTxTimeStamp(LCD *LCD_Struct)
+{
+    return LCD_Struct->terminal.txTimestamp;
+}
+
+static void LCD_DPipe_resetSendCount(LCD *LCD_Struct)
+{
+    LCD_Struct->terminal.sendCount = 0;
+}
+
+/*
+ * @LCD_DPipe_clearTx.
+ * @brief: Clear the terminal, the blank frame is sent with the next write or flush.
+ */
+static void LCD_DPipe_clearTx(LCD *LCD_Struct)
+{
+    LCD_PrintClear(LCD_Struct);
+    LCD_Struct->terminal.row = 0;
+    LCD_Struct->terminal.col = 0;
+}
+
+/*
+ * @LCD_DPipe_read.
+ * @brief: The LCD has no input, nothing is ever read.
+ */
+static boolean LCD_DPipe_read(LCD *LCD_Struct, void *data, Ifx_SizeT *count, Ifx_TickTime timeout)
+{
+    (void)LCD_Struct;
+    (void)data;
+    (void)timeout;
+    *count = 0;
+    return FALSE;
+}
+
+static sint32 LCD_DPipe_getReadCount(LCD *LCD_Struct)
+{
+    (void)LCD_Struct;
+    return 0;
+}
+
+static IfxStdIf_DPipe_ReadEvent LCD_DPipe_getReadEvent(LCD *LCD_Struct)
+{
+    (void)LCD_Struct;
+    return NULL_PTR;
+}
+
+static boolean LCD_DPipe_canReadCount(LCD *LCD_Struct, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    (void)LCD_Struct;
+    (void)timeout;
+    return count == 0;
+}
+
+/*
+ * @LCD_DPipe_onEvent.
+ * @brief: No interrupt belongs to the pipe, used for clearRx and the interrupt events.
+ */
+static void LCD_DPipe_onEvent(LCD *LCD_Struct)
+{
+    (void)LCD_Struct;
+}
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+boolean LCD_stdIfDPipeInit(IfxStdIf_DPipe *stdif, LCD *LCD_Struct)
+{
+    memset(stdif, 0, sizeof(IfxStdIf_DPipe));
+    memset(&LCD_Struct->terminal, 0, sizeof(LCD_TERMINAL));
+
+    stdif->driver         = LCD_Struct;
+    stdif->write          = (IfxStdIf_DPipe_Write) & LCD_DPipe_write;
+    stdif->read           = (IfxStdIf_DPipe_Read) & LCD_DPipe_read;
+    stdif->getReadCount   = (IfxStdIf_DPipe_GetReadCount) & LCD_DPipe_getReadCount;
+    stdif->getReadEvent   = (IfxStdIf_DPipe_GetReadEvent) & LCD_DPipe_getReadEvent;
+    stdif->getWriteCount  = (IfxStdIf_DPipe_GetWriteCount) & LCD_DPipe_getWriteCount;
+    stdif->getWriteEvent  = (IfxStdIf_DPipe_GetWriteEvent) & LCD_DPipe_getWriteEvent;
+    stdif->canReadCount   = (IfxStdIf_DPipe_CanReadCount) & LCD_DPipe_canReadCount;
+    stdif->canWriteCount  = (IfxStdIf_DPipe_CanWriteCount) & LCD_DPipe_canWriteCount;
+    stdif->flushTx        = (IfxStdIf_DPipe_FlushTx) & LCD_DPipe_flushTx;
+    stdif->clearTx        = (IfxStdIf_DPipe_ClearTx) & LCD_DPipe_clearTx;
+    stdif->clearRx        = (IfxStdIf_DPipe_ClearRx) & LCD_DPipe_onEvent;
+    stdif->onReceive      = (IfxStdIf_DPipe_OnReceive) & LCD_DPipe_onEvent;
+    stdif->onTransmit     = (IfxStdIf_DPipe_OnTransmit) & LCD_DPipe_onEvent;
+    stdif->onError        = (IfxStdIf_DPipe_OnError) & LCD_DPipe_onEvent;
+    stdif->getSendCount   = (IfxStdIf_DPipe_GetSendCount) & LCD_DPipe_getSendCount;
+    stdif->getTxTimeStamp = (IfxStdIf_DPipe_GetTxTimeStamp) & LCD_DPipe_getTxTimeStamp;
+    stdif->resetSendCount = (IfxStdIf_DPipe_ResetSendCount) & LCD_DPipe_resetSendCount;
+    stdif->txDisabled     = FALSE;
+    return TRUE;
+}
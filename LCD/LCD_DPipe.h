@@ -0,0 +1,37 @@
+/**********************************************************************************************************************
+ * \file    LCD_DPipe.h
+ * \brief   Standard interface data pipe on the LCD, so Ifx_Console and Ifx_Shell can print on it.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+#ifndef LCD_LCD_DPIPE_H_
+#define LCD_LCD_DPIPE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "LCD.h"
+#include "StdIf/IfxStdIf_DPipe.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ *@LCD_stdIfDPipeInit
+ *@brief: Initialize the standard interface to use the LCD as a write-only terminal, e.g. with
+ *        Ifx_Console_init(&stdif). The text is laid on the frame of the LCD like on a terminal: '\r' returns to
+ *        the 1st column, '\n' goes to the next row, '\b' moves back, a full row wraps and the screen scrolls up
+ *        past the last row. Each write sends the changed cells only, as runs of @ref LCD_Flush.
+ *        getWriteCount tells the chars a write can show; with @ref LCD_AsyncInit it is also limited by the free
+ *        room in the queue. flushTx returns once the LCD shows the text.
+ *@param: Pointer to the standard interface.
+ *@param: LCD_struct pointer to structure @ref LCD, initialized and begun.
+ *@return: TRUE.
+ */
+boolean LCD_stdIfDPipeInit(IfxStdIf_DPipe *stdif, LCD *LCD_Struct);
+
+#endif /* LCD_LCD_DPIPE_H_ */
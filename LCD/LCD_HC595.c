@@ -0,0 +1,187 @@
+/**********************************************************************************************************************
+ * \file    LCD_HC595.c
+ * \brief   Transport of the LCD driver through a 74HC595 shift register on QSPI.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "LCD_HC595.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Private Functions-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_Hc595_IsBusy.
+ * @brief: Tell if an exchange is in progress.
+ */
+static boolean LCD_Hc595_IsBusy(LCD *LCD_Struct)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+
+    return IfxQspi_SpiMaster_getStatus(shifter->channel) == SpiIf_Status_busy;
+}
+
+/*
+ * @LCD_Hc595_Wait.
+ * @brief: Wait the end of the exchange in progress.
+ */
+static void LCD_Hc595_Wait(LCD *LCD_Struct)
+{
+    while(LCD_Hc595_IsBusy(LCD_Struct))
+    {}
+}
+
+/*
+ * @LCD_Hc595_Flush.
+ * @brief: Start the exchange of the active buffer and fill the other one meanwhile.
+ *         The other buffer is free once the previous exchange is over.
+ */
+static void LCD_Hc595_Flush(LCD *LCD_Struct)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+
+    if(shifter->length == 0)
+        return;
+
+    LCD_Hc595_Wait(LCD_Struct);
+    while(IfxQspi_SpiMaster_exchange(shifter->channel, shifter->buffer[shifter->active], NULL_PTR,
+            shifter->length) == SpiIf_Status_busy)
+    {}
+    ++shifter->transfers;
+    shifter->frames += shifter->length;
+    shifter->active ^= 1;
+    shifter->length = 0;
+}
+
+/*
+ * @LCD_Hc595_Frames.
+ * @brief: Number of whole frames covering a time, at least one.
+ */
+static uint32 LCD_Hc595_Frames(LCD_HC595 *shifter, uint32 time_ns)
+{
+    uint32 frames = (time_ns + shifter->frame_ns - 1) / shifter->frame_ns;
+
+    return (frames > 0) ? frames : 1;
+}
+
+/*
+ * @LCD_Hc595_Timing.
+ * @brief: Convert the times of @ref LCD_TIMING to frames when they change. E high is repeated until the enable
+ *         pulse is over, E low until the enable cycle is over, the setup frame of the next nibble included.
+ */
+static void LCD_Hc595_Timing(LCD *LCD_Struct)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+    const LCD_TIMING *timing = &LCD_Struct->timing;
+    uint32 exec_ns = timing->exec_us * 1000;
+    uint32 frames;
+
+    if((shifter->exec_ns == exec_ns) && (shifter->pulse_ns == timing->enablePulse_ns)
+            && (shifter->cycle_ns == timing->enableCycle_ns))
+        return;
+
+    shifter->highFrames = (uint16)LCD_Hc595_Frames(shifter, timing->enablePulse_ns);
+    frames = LCD_Hc595_Frames(shifter, timing->enableCycle_ns);
+    shifter->lowFrames = (frames > shifter->highFrames + 2U) ? (uint16)(frames - shifter->highFrames - 1) : 1;
+
+    //The E low states and the next setup state already take part of the execution time.
+    frames = LCD_Hc595_Frames(shifter, exec_ns);
+    shifter->padding = (frames > shifter->lowFrames + 1U) ? (uint16)(frames - shifter->lowFrames - 1) : 0;
+
+    shifter->exec_ns = exec_ns;
+    shifter->pulse_ns = timing->enablePulse_ns;
+    shifter->cycle_ns = timing->enableCycle_ns;
+}
+
+/*
+ * @LCD_Hc595_Append.
+ * @brief: Append a state repeated count times, flushing the buffer each time it is full.
+ */
+static void LCD_Hc595_Append(LCD *LCD_Struct, uint8 state, uint16 count)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+
+    while(count-- > 0){
+        if(shifter->length == LCD_HC595_BUFFER_LENGTH)
+            LCD_Hc595_Flush(LCD_Struct);
+        shifter->buffer[shifter->active][shifter->length++] = state;
+    }
+}
+
+/*
+ * @LCD_Hc595_Write.
+ * @brief: Append the states of a byte: for each nibble data setup, E high and E low, then idle states
+ *         until the execution time of the LCD is over.
+ */
+static void LCD_Hc595_Write(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+    uint8 nibbles = (flags & LCD_SEND_NIBBLE) ? 1 : 2;
+    uint8 control = shifter->backlight | ((flags & LCD_SEND_DATA) ? LCD_HC595_RS : 0);
+
+    LCD_Hc595_Timing(LCD_Struct);
+
+    //The nibbles of the byte are not split over two exchanges, so the gap between them never stretches E high.
+    //Only the idle padding that follows may go to the next exchange.
+    if(shifter->length + nibbles * (1U + shifter->highFrames + shifter->lowFrames) > LCD_HC595_BUFFER_LENGTH)
+        LCD_Hc595_Flush(LCD_Struct);
+
+    for(uint8 n = 0; n < nibbles; ++n){
+        uint8 state = control | (((n == 0) ? value : (uint8)(value << 4)) & 0XF0);
+
+        LCD_Hc595_Append(LCD_Struct, state, 1);
+        LCD_Hc595_Append(LCD_Struct, state | LCD_HC595_E, shifter->highFrames);
+        LCD_Hc595_Append(LCD_Struct, state, shifter->lowFrames);
+    }
+    LCD_Hc595_Append(LCD_Struct, shifter->backlight, shifter->padding);
+}
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Global Variables-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static const LCD_TRANSPORT LCD_Hc595_Transport = {
+        .write = LCD_Hc595_Write,
+        .flush = LCD_Hc595_Flush,
+        .isBusy = LCD_Hc595_IsBusy
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+LCD* LCD_Hc595Init(LCD *storage, LCD_HC595 *shifter, IfxQspi_SpiMaster_Channel *channel, uint32 gap_ns)
+{
+    shifter->channel = channel;
+    shifter->frame_ns = (uint32)(8000000000ULL / (uint32)channel->base.baudrate) + gap_ns;
+    shifter->exec_ns = shifter->pulse_ns = shifter->cycle_ns = 0XFFFFFFFF;
+    shifter->highFrames = shifter->lowFrames = 1;
+    shifter->padding = 0;
+    shifter->backlight = LCD_HC595_BACKLIGHT;
+    shifter->active = 0;
+    shifter->length = 0;
+    shifter->transfers = 0;
+    shifter->frames = 0;
+
+    return LCD_InitTransport(storage, &LCD_Hc595_Transport, shifter);
+}
+
+void LCD_Hc595SetBacklight(LCD *LCD_Struct, boolean on)
+{
+    LCD_HC595 *shifter = (LCD_HC595 *)LCD_Struct->transportData;
+
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    //The transport belongs to the interrupt of the asynchronous mode until the queue is empty.
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+    //The LCD lines are left idle: E low, RS low.
+    shifter->backlight = on ? LCD_HC595_BACKLIGHT : 0;
+    LCD_Hc595_Append(LCD_Struct, shifter->backlight, 1);
+    LCD_Hc595_Flush(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
+}
@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+ * \file    LCD_HC595.h
+ * \brief   Transport of the LCD driver through a 74HC595 shift register on QSPI.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+#ifndef LCD_LCD_HC595_H_
+#define LCD_LCD_HC595_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "LCD.h"
+#include "Qspi/SpiMaster/IfxQspi_SpiMaster.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Defines-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @HC595_PINS
+ * @brief: Outputs of the shift register, QA is bit 0. Q4-Q7 are DB4-DB7, RW is tied low.
+ */
+#ifndef LCD_HC595_RS
+#define LCD_HC595_RS            0X01
+#define LCD_HC595_E             0X04
+#define LCD_HC595_BACKLIGHT     0X08
+#endif
+
+/*
+ * @HC595_BUFFER
+ * @brief: Shift register states of each of the two buffers, one is filled while the other is sent.
+ */
+#ifndef LCD_HC595_BUFFER_LENGTH
+#define LCD_HC595_BUFFER_LENGTH     512
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_HC595_STRUCTURE
+ * @brief: State of the shift register transport. Each QSPI frame is one state of the outputs, latched by SLSO.
+ */
+typedef struct _LCD_HC595{
+        IfxQspi_SpiMaster_Channel *channel;
+        uint32 frame_ns;                //Frame time: 8 bits plus the ECON gap.
+        uint32 exec_ns;                 //Execution time the frame counts were computed for.
+        uint32 pulse_ns;                //Enable pulse the frame counts were computed for.
+        uint32 cycle_ns;                //Enable cycle the frame counts were computed for.
+        uint16 highFrames;              //Frames of E high, at least the enable pulse.
+        uint16 lowFrames;               //Frames of E low after each nibble, so the enable cycle is kept.
+        uint16 padding;                 //Idle frames after each byte to cover the execution time, split over
+                                        //several exchanges when it does not fit in a buffer.
+        uint8 backlight;                //LCD_HC595_BACKLIGHT or 0, ORed in every state.
+        uint8 active;                   //Buffer being filled.
+        uint16 length;                  //States waiting in the active buffer.
+        uint32 transfers;               //QSPI exchanges started.
+        uint32 frames;                  //Frames sent.
+        uint8 buffer[2][LCD_HC595_BUFFER_LENGTH];
+}LCD_HC595;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ *@LCD_Hc595Init
+ *@brief: Initialize a LCD on a 74HC595, then use it as any other LCD starting with @ref LCD_Begin.
+ *        The channel must be 8 bits wide with channelBasedCs enabled and SLSO wired to the latch clock, so
+ *        every frame updates the outputs; configure the module with DMA to leave the CPU out of the transfer.
+ *        The bytes written by a LCD_* call are sent by a single IfxQspi_SpiMaster_exchange, and the call
+ *        returns while they are shifted out.
+ *@param: Pointer to the storage of the structure @ref LCD.
+ *@param: Pointer to the storage of the transport, it must live as long as the LCD.
+ *@param: QSPI channel of the shift register, initialized by the application.
+ *@param: Gap between two frames given by the ECON idle, lead and trail delays of the channel, in ns.
+ *@return: Pointer to the initialized LCD, i.e. storage.
+ */
+LCD* LCD_Hc595Init(LCD *storage, LCD_HC595 *shifter, IfxQspi_SpiMaster_Channel *channel, uint32 gap_ns);
+
+/*
+ *@LCD_Hc595SetBacklight
+ *@brief: Switch the backlight output of the shift register.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: TRUE to switch it on.
+ */
+void LCD_Hc595SetBacklight(LCD *LCD_Struct, boolean on);
+
+#endif /* LCD_LCD_HC595_H_ */
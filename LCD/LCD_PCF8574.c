@@ -0,0 +1,111 @@
+/**********************************************************************************************************************
+ * \file    LCD_PCF8574.c
+ * \brief   Transport of the LCD driver through a PCF8574 I2C backpack.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "LCD_PCF8574.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Private Functions-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_Pcf8574_Flush.
+ * @brief: Send the batched states in one I2C transaction.
+ */
+static void LCD_Pcf8574_Flush(LCD *LCD_Struct)
+{
+    LCD_PCF8574 *backpack = (LCD_PCF8574 *)LCD_Struct->transportData;
+
+    uint8 tries = 0;
+
+    if(backpack->length == 0)
+        return;
+
+    //A missing backpack never ACKs, the states are dropped instead of hanging the caller.
+    while(IfxI2c_I2c_write(backpack->device, backpack->buffer, backpack->length) == IfxI2c_I2c_Status_nak){
+        if(++tries == LCD_PCF8574_RETRIES){
+            ++backpack->failures;
+#if LCD_USE_STATS
+            ++LCD_Struct->stats.transportErrors;
+#endif
+            backpack->length = 0;
+            return;
+        }
+    }
+    ++backpack->transactions;
+    backpack->states += backpack->length;
+    backpack->length = 0;
+}
+
+/*
+ * @LCD_Pcf8574_Write.
+ * @brief: Batch the expander states of a byte: for each nibble data setup, E high and E low.
+ *         Data only changes while E is low, so the setup and hold times are kept by the I2C bit time.
+ */
+static void LCD_Pcf8574_Write(LCD *LCD_Struct, uint8 flags, uint8 value)
+{
+    LCD_PCF8574 *backpack = (LCD_PCF8574 *)LCD_Struct->transportData;
+    uint8 nibbles = (flags & LCD_SEND_NIBBLE) ? 1 : 2;
+    uint8 control = backpack->backlight | ((flags & LCD_SEND_DATA) ? LCD_PCF8574_RS : 0);
+
+    if(backpack->length + 3 * nibbles > LCD_PCF8574_BUFFER_LENGTH)
+        LCD_Pcf8574_Flush(LCD_Struct);
+
+    for(uint8 n = 0; n < nibbles; ++n){
+        uint8 state = control | (((n == 0) ? value : (uint8)(value << 4)) & 0XF0);
+
+        backpack->buffer[backpack->length++] = state;
+        backpack->buffer[backpack->length++] = state | LCD_PCF8574_E;
+        backpack->buffer[backpack->length++] = state;
+    }
+}
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Global Variables-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static const LCD_TRANSPORT LCD_Pcf8574_Transport = {
+        .write = LCD_Pcf8574_Write,
+        .flush = LCD_Pcf8574_Flush,
+        .isBusy = NULL
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+LCD* LCD_Pcf8574Init(LCD *storage, LCD_PCF8574 *backpack, IfxI2c_I2c_Device *device)
+{
+    backpack->device = device;
+    backpack->backlight = LCD_PCF8574_BACKLIGHT;
+    backpack->length = 0;
+    backpack->transactions = 0;
+    backpack->states = 0;
+    backpack->failures = 0;
+
+    return LCD_InitTransport(storage, &LCD_Pcf8574_Transport, backpack);
+}
+
+void LCD_Pcf8574SetBacklight(LCD *LCD_Struct, boolean on)
+{
+    LCD_PCF8574 *backpack = (LCD_PCF8574 *)LCD_Struct->transportData;
+
+    LCD_Lock(LCD_Struct, LCD_Call_setup);
+    //The transport belongs to the interrupt of the asynchronous mode until the queue is empty.
+    if(LCD_Struct->async != NULL)
+        LCD_AsyncWait(LCD_Struct);
+    if(backpack->length == LCD_PCF8574_BUFFER_LENGTH)
+        LCD_Pcf8574_Flush(LCD_Struct);
+    //The LCD lines are left idle: E low, RS and RW low.
+    backpack->backlight = on ? LCD_PCF8574_BACKLIGHT : 0;
+    backpack->buffer[backpack->length++] = backpack->backlight;
+    LCD_Pcf8574_Flush(LCD_Struct);
+    LCD_Unlock(LCD_Struct);
+}
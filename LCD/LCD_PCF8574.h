@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * \file    LCD_PCF8574.h
+ * \brief   Transport of the LCD driver through a PCF8574 I2C backpack.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+#ifndef LCD_LCD_PCF8574_H_
+#define LCD_LCD_PCF8574_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "LCD.h"
+#include "I2c/I2c/IfxI2c_I2c.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Defines-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @PCF8574_PINS
+ * @brief: Wiring of the usual backpacks, P4-P7 are DB4-DB7.
+ */
+#ifndef LCD_PCF8574_RS
+#define LCD_PCF8574_RS          0X01
+#define LCD_PCF8574_RW          0X02
+#define LCD_PCF8574_E           0X04
+#define LCD_PCF8574_BACKLIGHT   0X08
+#endif
+
+/*
+ * @PCF8574_BUFFER
+ * @brief: Expander states sent in one I2C transaction, each nibble takes 3 (data, E high, E low).
+ */
+#ifndef LCD_PCF8574_RETRIES
+#define LCD_PCF8574_RETRIES         3       //I2C writes tried before a NAK drops the states.
+#endif
+
+#ifndef LCD_PCF8574_BUFFER_LENGTH
+#define LCD_PCF8574_BUFFER_LENGTH   240
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_PCF8574_STRUCTURE
+ * @brief: State of the backpack, the expander states of a run of bytes are batched in buffer.
+ */
+typedef struct _LCD_PCF8574{
+        IfxI2c_I2c_Device *device;
+        uint8 backlight;                //LCD_PCF8574_BACKLIGHT or 0, ORed in every state.
+        uint16 length;                  //States waiting in buffer.
+        uint32 transactions;            //I2C transactions sent.
+        uint32 states;                  //Expander states sent.
+        uint32 failures;                //Transactions dropped after LCD_PCF8574_RETRIES NAKs, e.g. no backpack.
+        uint8 buffer[LCD_PCF8574_BUFFER_LENGTH];
+}LCD_PCF8574;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ *@LCD_Pcf8574Init
+ *@brief: Initialize a LCD on a PCF8574 backpack, then use it as any other LCD starting with @ref LCD_Begin.
+ *        The bytes written by a LCD_* call are sent in a single I2C transaction. The I2C bus must not be
+ *        faster than 400 kHz, so the serial time covers the execution time of each byte.
+ *@param: Pointer to the storage of the structure @ref LCD.
+ *@param: Pointer to the storage of the backpack, it must live as long as the LCD.
+ *@param: I2C device of the backpack, initialized by the application with IfxI2c_I2c_initDevice.
+ *@return: Pointer to the initialized LCD, i.e. storage.
+ */
+LCD* LCD_Pcf8574Init(LCD *storage, LCD_PCF8574 *backpack, IfxI2c_I2c_Device *device);
+
+/*
+ *@LCD_Pcf8574SetBacklight
+ *@brief: Switch the backlight of the backpack.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: TRUE to switch it on.
+ */
+void LCD_Pcf8574SetBacklight(LCD *LCD_Struct, boolean on);
+
+#endif /* LCD_LCD_PCF8574_H_ */
@@ -0,0 +1,144 @@
+/**********************************************************************************************************************
+ * \file    LCD_Server.c
+ * \brief   LCD display server: one core owns the LCD and the other cores post updates through lock-free queues.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "LCD_Server.h"
+#include <Stm/Std/IfxStm.h>
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Defines-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define STM             &MODULE_STM0
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Private Functions-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_Server_NonCached.
+ * @brief: Address of the LMU through segment 0XB, so each core sees the writes of the others at once.
+ */
+static LCD_SERVER_QUEUE* LCD_Server_NonCached(LCD_SERVER_QUEUE *queue)
+{
+    uint32 address = (uint32)queue;
+
+    if((address & 0XF0000000) == 0X90000000)
+        address |= 0X20000000;
+    return (LCD_SERVER_QUEUE *)address;
+}
+
+/*
+ * @LCD_Server_Drain.
+ * @brief: Apply the complete messages of a queue on the frame, in the order they were reserved.
+ *         A message reserved but not complete yet stops the drain until the next frame.
+ */
+static void LCD_Server_Drain(LCD_SERVER *server, LCD_SERVER_QUEUE *queue)
+{
+    uint32 head = queue->head;
+
+    while(head != queue->tail){
+        LCD_SERVER_MSG *msg = &queue->slot[head % LCD_SERVER_QUEUE_LENGTH];
+
+        if(!msg->ready)
+            break;
+        __dsync();
+        for(uint8 i = 0; i < msg->length; ++i){
+            LCD_PrintChar(server->lcd, msg->row, msg->col + i, msg->text[i]);
+        }
+        ++server->messages;
+
+        //The slot is given back before the head moves, a poster never writes a slot being read.
+        msg->ready = FALSE;
+        __dsync();
+        queue->head = ++head;
+    }
+    server->dropped += __swap((void *)&queue->dropped, 0);
+}
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+void LCD_ServerInit(LCD_SERVER *server, LCD *LCD_Struct, LCD_SERVER_QUEUE *queues, uint32 framePeriod_us)
+{
+    server->lcd = LCD_Struct;
+    for(uint8 i = 0; i < LCD_SERVER_CORES; ++i){
+        server->queue[i] = LCD_Server_NonCached(&queues[i]);
+        memset(server->queue[i], 0, sizeof(LCD_SERVER_QUEUE));
+    }
+    __dsync();
+
+    server->frameTicks = IfxStm_getTicksFromMicroseconds(STM, framePeriod_us);
+    server->nextFrame = IfxStm_get(STM);
+    server->frames = 0;
+    server->messages = 0;
+    server->dropped = 0;
+}
+
+boolean LCD_ServerPost(LCD_SERVER_QUEUE *queues, uint8 row, uint8 col, const uint8 *text)
+{
+    LCD_SERVER_QUEUE *queue = LCD_Server_NonCached(&queues[IfxCpu_getCoreIndex()]);
+    LCD_SERVER_MSG *msg;
+    uint32 tail, dropped;
+    uint8 length = 0;
+
+    //Reserve a slot, an interrupt of the same core posting meanwhile makes the CMPSWAP fail and retry.
+    do{
+        tail = queue->tail;
+        if(tail - queue->head >= LCD_SERVER_QUEUE_LENGTH){
+            do{
+                dropped = queue->dropped;
+            }while(__cmpAndSwap((unsigned int volatile *)&queue->dropped, dropped + 1, dropped) != dropped);
+            return FALSE;
+        }
+    }while(__cmpAndSwap((unsigned int volatile *)&queue->tail, tail + 1, tail) != tail);
+
+    msg = &queue->slot[tail % LCD_SERVER_QUEUE_LENGTH];
+    msg->row = row;
+    msg->col = col;
+    while((length < LCD_SERVER_TEXT_LENGTH) && (text[length] != 0)){
+        msg->text[length] = text[length];
+        ++length;
+    }
+    msg->length = length;
+
+    //The message is complete in the LMU before the server can see it.
+    __dsync();
+    msg->ready = TRUE;
+
+    return TRUE;
+}
+
+boolean LCD_ServerPoll(LCD_SERVER *server)
+{
+    uint64 now = IfxStm_get(STM);
+
+    if(now < server->nextFrame)
+        return FALSE;
+
+    //All the updates of the period land on the frame, a cell written twice is only sent once.
+    for(uint8 i = 0; i < LCD_SERVER_CORES; ++i){
+        LCD_Server_Drain(server, server->queue[i]);
+    }
+    LCD_Flush(server->lcd);
+    ++server->frames;
+    server->nextFrame = now + server->frameTicks;
+
+    return TRUE;
+}
+
+void LCD_ServerRun(LCD_SERVER *server)
+{
+    while(1){
+        LCD_ServerPoll(server);
+    }
+}
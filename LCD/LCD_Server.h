@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * \file    LCD_Server.h
+ * \brief   LCD display server: one core owns the LCD and the other cores post updates through lock-free queues.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+#ifndef LCD_LCD_SERVER_H_
+#define LCD_LCD_SERVER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "LCD.h"
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Defines-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @SERVER_SIZES
+ * @brief: Messages each core can have waiting, and chars of a message.
+ */
+#ifndef LCD_SERVER_QUEUE_LENGTH
+#define LCD_SERVER_QUEUE_LENGTH     16
+#endif
+#ifndef LCD_SERVER_TEXT_LENGTH
+#define LCD_SERVER_TEXT_LENGTH      20
+#endif
+
+/*
+ * @LCD_SERVER_CORES
+ * @brief: One queue per core that may post.
+ */
+#define LCD_SERVER_CORES            IFXCPU_NUM_MODULES
+
+/*
+ * @LCD_LMU_SECTION
+ * @brief: Place a variable in the LMU RAM, shared by all the CPUs.
+ */
+#if defined(__HIGHTEC__)
+#define LCD_LMU_SECTION         __attribute__ ((section(".bss_lmu")))
+#else
+#define LCD_LMU_SECTION
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_SERVER_MSG_STRUCTURE
+ * @brief: Text to be shown at a position, ready is set by the poster once the message is complete.
+ */
+typedef struct _LCD_SERVER_MSG{
+        uint8 row;
+        uint8 col;
+        uint8 length;
+        volatile uint8 ready;
+        uint8 text[LCD_SERVER_TEXT_LENGTH];
+}LCD_SERVER_MSG;
+
+/*
+ * @LCD_SERVER_QUEUE_STRUCTURE
+ * @brief: Queue of the messages of one core, read by the server only. Slots are reserved with CMPSWAP, so
+ *         the tasks and interrupts of that core can post without disabling the interrupts.
+ */
+typedef struct _LCD_SERVER_QUEUE{
+        volatile uint32 head;       //Next message to be read, written by the server.
+        volatile uint32 tail;       //Next slot to be reserved, written by the posters.
+        volatile uint32 dropped;    //Messages not posted because the queue was full.
+        LCD_SERVER_MSG slot[LCD_SERVER_QUEUE_LENGTH];
+}LCD_SERVER_QUEUE;
+
+/*
+ * @LCD_SERVER_STRUCTURE
+ * @brief: State of the server, it lives in the memory of the core that runs it.
+ */
+typedef struct _LCD_SERVER{
+        LCD *lcd;
+        LCD_SERVER_QUEUE *queue[LCD_SERVER_CORES];  //Not cached alias of each queue.
+        uint32 frameTicks;          //STM ticks between two frames.
+        uint64 nextFrame;           //STM time of the next frame.
+
+        uint32 frames;              //Frames sent.
+        uint32 messages;            //Messages applied to the frames.
+        uint32 dropped;             //Messages dropped by the posters, collected by the server.
+}LCD_SERVER;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ *@LCD_ServerInit
+ *@brief: Initialize the server on the core that owns the LCD, before the other cores post.
+ *@param: Pointer to the server.
+ *@param: LCD_struct pointer to structure @ref LCD, initialized and begun.
+ *@param: Array of LCD_SERVER_CORES queues, defined with LCD_LMU_SECTION.
+ *@param: Frame period in us, the updates posted meanwhile are sent together.
+ */
+void LCD_ServerInit(LCD_SERVER *server, LCD *LCD_Struct, LCD_SERVER_QUEUE *queues, uint32 framePeriod_us);
+
+/*
+ *@LCD_ServerPost
+ *@brief: Post a text to be shown at a position, from any core. It never blocks: if the queue of the core is full
+ *        the message is dropped and counted.
+ *@param: Array of queues given to @ref LCD_ServerInit, the queue of the calling core is used.
+ *@param: Row.
+ *@param: Column.
+ *@param: Zero terminated text, cut at LCD_SERVER_TEXT_LENGTH chars and at the last column.
+ *@return: FALSE if the message was dropped.
+ */
+boolean LCD_ServerPost(LCD_SERVER_QUEUE *queues, uint8 row, uint8 col, const uint8 *text);
+
+/*
+ *@LCD_ServerPoll
+ *@brief: Once the frame period is over, apply every message waiting on the frame of the LCD and send
+ *        the changed cells once. Call it from the main loop of the server core.
+ *@param: Pointer to the server.
+ *@return: TRUE if a frame was sent.
+ */
+boolean LCD_ServerPoll(LCD_SERVER *server);
+
+/*
+ *@LCD_ServerRun
+ *@brief: Main loop of a core dedicated to the LCD, it never returns.
+ *@param: Pointer to the server.
+ */
+void LCD_ServerRun(LCD_SERVER *server);
+
+#endif /* LCD_LCD_SERVER_H_ */
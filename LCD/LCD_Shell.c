@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * \file    LCD_Shell.c
+ * \brief   Ifx_Shell commands showing the counters of the LCD driver, built with LCD_USE_STATS set to 1.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "LCD_Shell.h"
+
+#if LCD_USE_STATS
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Global Variables-------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static const pchar LCD_Shell_callNames[LCD_Call_count] = {
+        "setup", "begin", "clear", "write", "glyph", "frame", "read"
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+boolean LCD_ShellStats(pchar args, void *data, IfxStdIf_DPipe *io)
+{
+    LCD *LCD_Struct = (LCD *)data;
+    const LCD_STATS *stats = &LCD_Struct->stats;
+
+    (void)args;
+    IfxStdIf_DPipe_print(io, "commands %lu, data %lu, strobes %lu, transport errors %lu"ENDL, (unsigned long)stats->commands,
+            (unsigned long)stats->dataBytes, (unsigned long)stats->strobes, (unsigned long)stats->transportErrors);
+    IfxStdIf_DPipe_print(io, "cycles %llu, worst %lu (%s)"ENDL, (unsigned long long)stats->cycles,
+            (unsigned long)stats->worstCycles, LCD_Shell_callNames[stats->worstCall]);
+
+    //Bin b counts the calls below 512 << b cycles, the last one the longer calls.
+    for(uint8 call = 0; call < LCD_Call_count; ++call){
+        if(stats->calls[call] == 0)
+            continue;
+        IfxStdIf_DPipe_print(io, "%-5s %8lu:", LCD_Shell_callNames[call], (unsigned long)stats->calls[call]);
+        for(uint8 bin = 0; bin < LCD_STATS_BINS; ++bin){
+            IfxStdIf_DPipe_print(io, " %lu", (unsigned long)stats->histogram[call][bin]);
+        }
+        IfxStdIf_DPipe_print(io, ENDL);
+    }
+    return TRUE;
+}
+
+boolean LCD_ShellReset(pchar args, void *data, IfxStdIf_DPipe *io)
+{
+    (void)args;
+    LCD_StatsReset((LCD *)data);
+    IfxStdIf_DPipe_print(io, "LCD counters cleared"ENDL);
+    return TRUE;
+}
+
+#endif /* LCD_USE_STATS */
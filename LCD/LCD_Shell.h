@@ -0,0 +1,62 @@
+/**********************************************************************************************************************
+ * \file    LCD_Shell.h
+ * \brief   Ifx_Shell commands showing the counters of the LCD driver, built with LCD_USE_STATS set to 1.
+ * \version V1.0.0
+ * \date    15 jul. 2022
+ * \author  Fidel
+ *********************************************************************************************************************/
+
+#ifndef LCD_LCD_SHELL_H_
+#define LCD_LCD_SHELL_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "LCD.h"
+#include "SysSe/Comm/Ifx_Shell.h"
+
+#if LCD_USE_STATS
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Defines-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ * @LCD_SHELL_COMMANDS
+ * @brief: Command list "lcd stats" / "lcd reset" of a LCD, to be added to the commandList of Ifx_Shell_Config:
+ *         const Ifx_Shell_Command lcdCommands[] = {LCD_SHELL_COMMANDS(&Lcd)};
+ */
+#define LCD_SHELL_COMMANDS(lcd) \
+        {"lcd", "   : LCD driver", NULL_PTR, NULL_PTR}, \
+        {"stats", " : show the bus counters and the cycles of the calls", (lcd), &LCD_ShellStats}, \
+        {"reset", " : clear the counters", (lcd), &LCD_ShellReset}, \
+        {NULL_PTR, NULL_PTR, NULL_PTR, NULL_PTR}
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*
+ *@LCD_ShellStats
+ *@brief: Ifx_Shell command printing @ref LCD_STATS: bus counters, cycles, worst call and latency histogram.
+ *@param: Arguments of the command, not used.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pipe of the shell.
+ *@return: TRUE.
+ */
+boolean LCD_ShellStats(pchar args, void *data, IfxStdIf_DPipe *io);
+
+/*
+ *@LCD_ShellReset
+ *@brief: Ifx_Shell command clearing the counters with @ref LCD_StatsReset.
+ *@param: Arguments of the command, not used.
+ *@param: LCD_struct pointer to structure @ref LCD.
+ *@param: Pipe of the shell.
+ *@return: TRUE.
+ */
+boolean LCD_ShellReset(pchar args, void *data, IfxStdIf_DPipe *io);
+
+#endif /* LCD_USE_STATS */
+
+#endif /* LCD_LCD_SHELL_H_ */
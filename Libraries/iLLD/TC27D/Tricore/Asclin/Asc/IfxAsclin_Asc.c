@@ -475,16 +475,24 @@ void IfxAsclin_Asc_isrReceive(IfxAsclin_Asc *asclin)
     {
     case Ifx_DataBufferMode_normal:
     {
-        uint8 count;
+        uint8                   count;
+        Ifx_CircularBuffer_Span span1, span2;
         count = IfxAsclin_getRxFifoFillLevel(asclin->asclin);
-        IfxAsclin_read8(asclin->asclin, &ascData[0], count);
 
-        if (Ifx_Fifo_write(asclin->rx, &ascData[0], count, TIME_NULL) != 0)
+        /* The data are read from the hardware FIFO directly into the software FIFO */
+        if (Ifx_Fifo_reserveWrite(asclin->rx, &span1, &span2) < count)
         {
             /* Receive buffer is full, data is discard */
             asclin->rxSwFifoOverflow = TRUE;
         }
 
+        span1.length = __min(span1.length, count);
+        span2.length = __min(span2.length, count - span1.length);
+        IfxAsclin_read8(asclin->asclin, span1.data, span1.length);
+        IfxAsclin_read8(asclin->asclin, span2.data, span2.length);
+        Ifx_Fifo_commitWrite(asclin->rx, span1.length + span2.length);
+        IfxAsclin_read8(asclin->asclin, &ascData[0], count - span1.length - span2.length);
+
         break;
     }
     case Ifx_DataBufferMode_timeStampSingle:
@@ -520,23 +528,21 @@ void IfxAsclin_Asc_isrTransmit(IfxAsclin_Asc *asclin)
         {
         case Ifx_DataBufferMode_normal:
         {
-            uint8          ascData[16];
-            uint16         count            = 0, i_count = 0;
-            volatile uint8 hw_tx_fill_level = 0;
+            Ifx_CircularBuffer_Span span1, span2;
+            uint16                  i_count          = 0;
+            volatile uint8          hw_tx_fill_level = 0;
 
-            count            = Ifx_Fifo_readCount(asclin->tx); /*SW FIFO fill level*/
+            Ifx_Fifo_peekRead(asclin->tx, &span1, &span2); /*SW FIFO data, written in place to the hardware FIFO*/
 
             hw_tx_fill_level = IfxAsclin_getTxFifoFillLevel(asclin->asclin);
 
             i_count          = (16 - hw_tx_fill_level);
 
-            if (i_count > count)
-            {
-                i_count = count;
-            }
-
-            Ifx_Fifo_read(asclin->tx, &ascData[0], i_count, TIME_NULL);
-            IfxAsclin_write8(asclin->asclin, &ascData[0], i_count);
+            span1.length     = __min(span1.length, i_count);
+            span2.length     = __min(span2.length, i_count - span1.length);
+            IfxAsclin_write8(asclin->asclin, span1.data, span1.length);
+            IfxAsclin_write8(asclin->asclin, span2.data, span2.length);
+            Ifx_Fifo_releaseRead(asclin->tx, span1.length + span2.length);
         }
         break;
 
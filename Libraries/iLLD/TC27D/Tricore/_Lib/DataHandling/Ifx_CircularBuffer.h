@@ -57,6 +57,14 @@
 /** \addtogroup IfxLld_lib_datahandling_circularbuffer
  * \{
  */
+/** \brief Contiguous region of a circular buffer
+ */
+typedef struct
+{
+    void     *data;                 /**< \brief region start address */
+    Ifx_SizeT length;               /**< \brief region length in bytes, 0 if the region is empty */
+} Ifx_CircularBuffer_Span;
+
 /** \brief Return the circular buffer 16 bit value, and post-increment the circular buffer pointer
  *
  * \param buffer Specifies circular buffer.
@@ -113,6 +121,49 @@ const void *Ifx_CircularBuffer_write8(Ifx_CircularBuffer *buffer, const void *da
  */
 const void *Ifx_CircularBuffer_write32(Ifx_CircularBuffer *buffer, const void *data, Ifx_SizeT count);
 
+/** \brief Return the count bytes that follow the circular buffer pointer as two contiguous regions
+ *
+ * The 1st region starts at the circular buffer pointer, the 2nd one at the buffer base when the
+ * count bytes wrap around the end of the buffer, else its length is 0. The pointer is not moved.
+ *
+ * \param buffer Specifies circular buffer.
+ * \param count Specifies number of bytes. count MUST be <= buffer->length.
+ * \param span1 Returns the region before the wrap point.
+ * \param span2 Returns the region after the wrap point.
+ *
+ * \return None
+ */
+IFX_INLINE void Ifx_CircularBuffer_getSpans(Ifx_CircularBuffer *buffer, Ifx_SizeT count, Ifx_CircularBuffer_Span *span1, Ifx_CircularBuffer_Span *span2)
+{
+    Ifx_SizeT length = __min(count, (Ifx_SizeT)(buffer->length - buffer->index));
+
+    span1->data   = &((uint8 *)buffer->base)[buffer->index];
+    span1->length = length;
+    span2->data   = buffer->base;
+    span2->length = count - length;
+}
+
+
+/** \brief Move the circular buffer pointer by count bytes without copying data
+ *
+ * \param buffer Specifies circular buffer.
+ * \param count Specifies number of bytes. count MUST be <= buffer->length.
+ *
+ * \return None
+ */
+IFX_INLINE void Ifx_CircularBuffer_skip(Ifx_CircularBuffer *buffer, Ifx_SizeT count)
+{
+    uint32 index = (uint32)buffer->index + (uint32)count;
+
+    if (index >= buffer->length)
+    {
+        index -= buffer->length;
+    }
+
+    buffer->index = (uint16)index;
+}
+
+
 /** \} */
 //---------------------------------------------------------------------------
 #endif
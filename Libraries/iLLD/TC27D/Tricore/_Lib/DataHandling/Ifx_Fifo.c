@@ -63,6 +63,12 @@
  * the interrupt is not disabled in the IntfifoXXX() functions
  * This is valid is an OS is used.
  *
+ * In the single producer / single consumer mode (Ifx_Fifo_initSpsc()) the
+ * interrupts are never disabled: the reader only modifies readTotal and
+ * startIndex, the writer only modifies writeTotal, endIndex and maxcount, and
+ * a __dsync() orders the data copy and the counter update, so the reader and
+ * the writer can also be on different CPUs.
+ *
  */
 //------------------------------------------------------------------------------
 Ifx_Fifo *Ifx_Fifo_create(Ifx_SizeT size, Ifx_SizeT elementSize)
@@ -108,12 +114,42 @@ Ifx_Fifo *Ifx_Fifo_init(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize)
         fifo->startIndex         = fifo->endIndex = 0;
         fifo->size               = size;
         fifo->elementSize        = elementSize;
+        fifo->spsc               = FALSE;
+        fifo->readTotal          = fifo->writeTotal = 0;
     }
 
     return fifo;
 }
 
 
+Ifx_Fifo *Ifx_Fifo_initSpsc(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize)
+{
+    Ifx_Fifo *fifo = Ifx_Fifo_init(buffer, size, elementSize);
+
+    fifo->spsc = TRUE;
+
+    return fifo;
+}
+
+
+/**
+ * Wait until the fifo contains at least count bytes (reader) or has at least count free bytes (writer)
+ * \return TRUE if the condition is met before the dead line
+ */
+static boolean Ifx_Fifo_waitSpsc(Ifx_Fifo *fifo, Ifx_SizeT count, boolean reader, Ifx_TickTime DeadLine)
+{
+    boolean result;
+
+    do
+    {
+        Ifx_SizeT available = (reader != FALSE) ? Ifx_Fifo_readCount(fifo) : Ifx_Fifo_writeCount(fifo);
+        result = available >= count;
+    } while ((result == FALSE) && (IfxStm_isDeadLine(DeadLine) == FALSE));
+
+    return result;
+}
+
+
 /**
  * param: count in bytes
  */
@@ -143,6 +179,10 @@ boolean Ifx_Fifo_canReadCount(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_TickTime time
     {                           /* Only complete elements can be read from the buffer */
         result = FALSE;
     }
+    else if (fifo->spsc != FALSE)
+    {
+        result = Ifx_Fifo_waitSpsc(fifo, count, TRUE, IfxStm_getDeadLine(timeout));
+    }
     else
     {
         boolean interruptState;
@@ -205,6 +245,49 @@ static Ifx_SizeT Ifx_Fifo_readEnd(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_SizeT blo
 }
 
 
+static Ifx_SizeT Ifx_Fifo_readSpsc(Ifx_Fifo *fifo, void *data, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    Ifx_TickTime       DeadLine;
+    Ifx_SizeT          blockSize;
+    Ifx_CircularBuffer buffer;
+    boolean            Stop = FALSE;
+
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;         /* size always fit into 16 bit */
+    buffer.index  = (uint16)fifo->startIndex;   /* startIndex always fit into size */
+    DeadLine      = IfxStm_getDeadLine(timeout);
+
+    do
+    {
+        blockSize  = __min(count, Ifx_Fifo_readCount(fifo));
+        blockSize -= blockSize % fifo->elementSize;
+
+        if (blockSize != 0)
+        {
+            __dsync();  /* writeTotal is read before the data */
+            data             = Ifx_CircularBuffer_read8(&buffer, data, blockSize);
+            count           -= blockSize;
+            fifo->startIndex = buffer.index;
+            __dsync();  /* the data are read before the space is given back to the writer */
+            fifo->readTotal += blockSize;
+        }
+
+        if ((Stop != FALSE) || (IfxStm_isDeadLine(DeadLine) != FALSE))
+        {
+            break;
+        }
+
+        if (count != 0)
+        {
+            /* If the function timeout, the maximum number of characters are read before returning */
+            Stop = Ifx_Fifo_waitSpsc(fifo, __min(count, fifo->size), TRUE, DeadLine) == FALSE;
+        }
+    } while (count != 0);
+
+    return count;
+}
+
+
 Ifx_SizeT Ifx_Fifo_read(Ifx_Fifo *fifo, void *data, Ifx_SizeT count, Ifx_TickTime timeout)
 {
     Ifx_TickTime       DeadLine;
@@ -215,7 +298,11 @@ Ifx_SizeT Ifx_Fifo_read(Ifx_Fifo *fifo, void *data, Ifx_SizeT count, Ifx_TickTim
     IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
     IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, data != NULL_PTR);
 
-    if (count != 0)
+    if ((count != 0) && (fifo->spsc != FALSE))
+    {
+        count = Ifx_Fifo_readSpsc(fifo, data, count, timeout);
+    }
+    else if (count != 0)
     {
         buffer.base   = fifo->buffer;
         buffer.length = (uint16)fifo->size;         /* size always fit into 16 bit */
@@ -260,6 +347,16 @@ void Ifx_Fifo_clear(Ifx_Fifo *fifo)
 {
     boolean interruptState;
 
+    if (fifo->spsc != FALSE)
+    {
+        /* Only the reader side is modified: the bytes written until now are dropped. maxcount belongs to the writer */
+        Ifx_SizeT count = Ifx_Fifo_readCount(fifo);
+        fifo->startIndex  = (Ifx_SizeT)((fifo->startIndex + count) % fifo->size);
+        __dsync();
+        fifo->readTotal  += count;
+        return;
+    }
+
     interruptState = IfxCpu_disableInterrupts();
 
     if (fifo->shared.writerWaitx != 0)
@@ -305,6 +402,10 @@ boolean Ifx_Fifo_canWriteCount(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_TickTime tim
         result = FALSE;
     }
 
+    else if (fifo->spsc != FALSE)
+    {
+        result = Ifx_Fifo_waitSpsc(fifo, count, FALSE, IfxStm_getDeadLine(timeout));
+    }
     else
     {
         boolean interruptState;
@@ -363,6 +464,50 @@ static Ifx_SizeT Ifx_Fifo_endWrite(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_SizeT bl
 
 
 
+static Ifx_SizeT Ifx_Fifo_writeSpsc(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    Ifx_TickTime       DeadLine;
+    Ifx_SizeT          blockSize;
+    Ifx_CircularBuffer buffer;
+    boolean            Stop = FALSE;
+
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;     /* size always fit into 16 bit */
+    buffer.index  = (uint16)fifo->endIndex; /* endIndex always fit into size */
+    DeadLine      = IfxStm_getDeadLine(timeout);
+
+    do
+    {
+        blockSize  = __min(count, Ifx_Fifo_writeCount(fifo));
+        blockSize -= blockSize % fifo->elementSize;
+
+        if (blockSize != 0)
+        {
+            __dsync();  /* readTotal is read before the buffer is overwritten */
+            data             = Ifx_CircularBuffer_write8(&buffer, data, blockSize);
+            count           -= blockSize;
+            fifo->endIndex   = buffer.index;
+            __dsync();  /* the data are written before they are given to the reader */
+            fifo->writeTotal += blockSize;
+            fifo->shared.maxcount = __max(fifo->shared.maxcount, Ifx_Fifo_readCount(fifo));   /* Update maximum value */
+        }
+
+        if ((Stop != FALSE) || (IfxStm_isDeadLine(DeadLine) != FALSE))
+        {
+            break;
+        }
+
+        if (count != 0)
+        {
+            /* If the function timeout, the maximum number of characters are written before returning */
+            Stop = Ifx_Fifo_waitSpsc(fifo, __min(count, fifo->size), FALSE, DeadLine) == FALSE;
+        }
+    } while (count != 0);
+
+    return count;
+}
+
+
 Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout)
 {
     Ifx_TickTime       DeadLine;
@@ -373,7 +518,11 @@ Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_
     IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
     IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, data != NULL_PTR);
 
-    if (count != 0)
+    if ((count != 0) && (fifo->spsc != FALSE))
+    {
+        count = Ifx_Fifo_writeSpsc(fifo, data, count, timeout);
+    }
+    else if (count != 0)
     {
         buffer.base   = fifo->buffer;
         buffer.length = (uint16)fifo->size;     /* size always fit into 16 bit */
@@ -413,4 +562,98 @@ Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_
     return count;
 }
 
+
+Ifx_SizeT Ifx_Fifo_reserveWrite(Ifx_Fifo *fifo, Ifx_CircularBuffer_Span *span1, Ifx_CircularBuffer_Span *span2)
+{
+    Ifx_SizeT          count;
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+
+    count         = Ifx_Fifo_writeCount(fifo);  /* The reader can only increase it */
+    count        -= count % fifo->elementSize;
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;         /* size always fit into 16 bit */
+    buffer.index  = (uint16)fifo->endIndex;     /* endIndex always fit into size */
+    Ifx_CircularBuffer_getSpans(&buffer, count, span1, span2);
+
+    return count;
+}
+
+
+void Ifx_Fifo_commitWrite(Ifx_Fifo *fifo, Ifx_SizeT count)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (count % fifo->elementSize) == 0);
+
+    if (count != 0)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;     /* size always fit into 16 bit */
+        buffer.index  = (uint16)fifo->endIndex; /* endIndex always fit into size */
+        Ifx_CircularBuffer_skip(&buffer, count);
+        fifo->endIndex = buffer.index;
+
+        if (fifo->spsc != FALSE)
+        {
+            __dsync();  /* the data are written before they are given to the reader */
+            fifo->writeTotal     += count;
+            fifo->shared.maxcount = __max(fifo->shared.maxcount, Ifx_Fifo_readCount(fifo));   /* Update maximum value */
+        }
+        else
+        {
+            Ifx_Fifo_endWrite(fifo, count, count);
+        }
+    }
+}
+
+
+Ifx_SizeT Ifx_Fifo_peekRead(Ifx_Fifo *fifo, Ifx_CircularBuffer_Span *span1, Ifx_CircularBuffer_Span *span2)
+{
+    Ifx_SizeT          count;
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+
+    count         = Ifx_Fifo_readCount(fifo);   /* The writer can only increase it */
+    count        -= count % fifo->elementSize;
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;         /* size always fit into 16 bit */
+    buffer.index  = (uint16)fifo->startIndex;   /* startIndex always fit into size */
+    Ifx_CircularBuffer_getSpans(&buffer, count, span1, span2);
+    __dsync();  /* the count is read before the data */
+
+    return count;
+}
+
+
+void Ifx_Fifo_releaseRead(Ifx_Fifo *fifo, Ifx_SizeT count)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (count % fifo->elementSize) == 0);
+
+    if (count != 0)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;         /* size always fit into 16 bit */
+        buffer.index  = (uint16)fifo->startIndex;   /* startIndex always fit into size */
+        Ifx_CircularBuffer_skip(&buffer, count);
+        fifo->startIndex = buffer.index;
+
+        if (fifo->spsc != FALSE)
+        {
+            __dsync();  /* the data are read before the space is given back to the writer */
+            fifo->readTotal += count;
+        }
+        else
+        {
+            Ifx_Fifo_readEnd(fifo, count, count);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
@@ -49,6 +49,7 @@
 //------------------------------------------------------------------------------
 #include "Ifx_Cfg.h"
 #include "Cpu/Std/IfxCpu_Intrinsics.h"
+#include "Ifx_CircularBuffer.h"
 //------------------------------------------------------------------------------
 
 /** Shared data of the FIFO
@@ -77,6 +78,9 @@ typedef struct _Fifo
     Ifx_SizeT        elementSize;           /**< \brief minimum number of bytes (block) added / removed to / from the buffer */
     volatile boolean eventReader;           /**< \brief event set by the writer to signal the reader that the required data are available in the buffer */
     volatile boolean eventWriter;           /**< \brief event set by the reader to signal the writer that the required free space are available in the buffer */
+    boolean          spsc;                  /**< \brief TRUE if initialized with \ref Ifx_Fifo_initSpsc(), the lock-free single producer / single consumer mode */
+    volatile uint32  readTotal;             /**< \brief SPSC mode: number of bytes read since the init, only modified by the reader */
+    volatile uint32  writeTotal;            /**< \brief SPSC mode: number of bytes written since the init, only modified by the writer */
 } Ifx_Fifo;
 
 /** \brief Indicates if the required number of bytes are available in the buffer
@@ -150,6 +154,26 @@ IFX_EXTERN void Ifx_Fifo_destroy(Ifx_Fifo *fifo);
  */
 IFX_EXTERN Ifx_Fifo *Ifx_Fifo_init(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize);
 
+/** \brief Initialize the FIFO buffer object in single producer / single consumer mode
+ *
+ * Same as \ref Ifx_Fifo_init(), but the reader and the writer only share the readTotal and writeTotal
+ * counters, each of them modified by one side only, with a __dsync() between the data copy and the counter
+ * update. Ifx_Fifo_read() and Ifx_Fifo_write() then run without disabling the interrupts, and the reader and
+ * the writer can run on different CPUs. The waits of the timeout poll the counters instead of the events.
+ *
+ * \param buffer Specifies the FIFO object address.
+ * \param size Specifies the FIFO buffer size in bytes
+ * \param elementSize Specifies data element size in bytes. size must be bigger or equal to elemenntSize.
+ *
+ * \return Returns a pointer on the FIFO object
+ *
+ * \note: Only one task / interrupt may write and only one may read. Ifx_Fifo_clear() must be called by the reader,
+ * it does not reset shared.maxcount, which only the writer updates.
+ * When the reader and the writer are on different CPUs, the FIFO object must be in a memory that is not cached
+ * by the data cache, e.g. the LMU through its non-cached segment 0xB0000000.
+ */
+IFX_EXTERN Ifx_Fifo *Ifx_Fifo_initSpsc(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize);
+
 /** \brief Read data from a fifo and remove them from the buffer.
  *
  * Only complete elements are returned, if count is not a multiple of
@@ -176,6 +200,51 @@ IFX_EXTERN Ifx_SizeT Ifx_Fifo_read(Ifx_Fifo *fifo, void *data, Ifx_SizeT count,
  */
 IFX_EXTERN Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout);
 
+/** \brief Return the free space of the fifo as up to two contiguous regions, to be filled in place
+ *
+ * The regions are filled by the writer (e.g. by a DMA or a peripheral driver) and handed to the
+ * reader with \ref Ifx_Fifo_commitWrite(), which replaces the copy of \ref Ifx_Fifo_write().
+ * The function does not wait, use \ref Ifx_Fifo_canWriteCount() to wait for free space.
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param span1 Returns the region that starts at the end of the fifo data
+ * \param span2 Returns the region that starts at the buffer base when the free space wraps around, else its length is 0
+ *
+ * \return Returns the free size in bytes, a multiple of fifo->elementSize
+ */
+IFX_EXTERN Ifx_SizeT Ifx_Fifo_reserveWrite(Ifx_Fifo *fifo, Ifx_CircularBuffer_Span *span1, Ifx_CircularBuffer_Span *span2);
+
+/** \brief Hand the first count bytes of the regions returned by \ref Ifx_Fifo_reserveWrite() to the reader
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes, a multiple of fifo->elementSize and not more than the reserved size
+ *
+ * \return None
+ */
+IFX_EXTERN void Ifx_Fifo_commitWrite(Ifx_Fifo *fifo, Ifx_SizeT count);
+
+/** \brief Return the data of the fifo as up to two contiguous regions, to be used in place
+ *
+ * The data stay in the fifo until \ref Ifx_Fifo_releaseRead(), which replaces the copy of \ref Ifx_Fifo_read().
+ * The function does not wait, use \ref Ifx_Fifo_canReadCount() to wait for data.
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param span1 Returns the region that starts at the oldest data
+ * \param span2 Returns the region that starts at the buffer base when the data wrap around, else its length is 0
+ *
+ * \return Returns the size of the data in bytes, a multiple of fifo->elementSize
+ */
+IFX_EXTERN Ifx_SizeT Ifx_Fifo_peekRead(Ifx_Fifo *fifo, Ifx_CircularBuffer_Span *span1, Ifx_CircularBuffer_Span *span2);
+
+/** \brief Remove the first count bytes of the regions returned by \ref Ifx_Fifo_peekRead() from the fifo
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes, a multiple of fifo->elementSize and not more than the peeked size
+ *
+ * \return None
+ */
+IFX_EXTERN void Ifx_Fifo_releaseRead(Ifx_Fifo *fifo, Ifx_SizeT count);
+
 /** \brief Empty the fifo
  *
  * \param fifo Pointer on the Fifo object
@@ -202,7 +271,7 @@ IFX_INLINE boolean Ifx_Fifo_flush(Ifx_Fifo *fifo, Ifx_TickTime timeout)
  */
 IFX_INLINE Ifx_SizeT Ifx_Fifo_readCount(Ifx_Fifo *fifo)
 {
-    return fifo->shared.count;
+    return (fifo->spsc != FALSE) ? (Ifx_SizeT)(fifo->writeTotal - fifo->readTotal) : fifo->shared.count;
 }
 
 